@@ -0,0 +1,195 @@
+// Copyright (c) 2026 Alex Li
+// BatchSearcher.hpp
+// Searches many positions at once, one position per task, over tables the
+// whole batch shares
+
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <vector>
+
+#include "../utils/ThreadPool.hpp"
+#include "EndgameSolver.hpp"
+#include "Engine.hpp"
+#include "GameBoard.hpp"
+#include "OpeningBook.hpp"
+#include "TranspositionTable.hpp"
+#include "evaluator/Evaluator.hpp"
+
+namespace othello {
+
+/// @brief Configuration of a BatchSearcher
+struct BatchOptions {
+  /// Table shared by the whole batch, unless the batch is given tables
+  size_t tt_size_mb = kDefaultTTSizeMB;
+  SearchDriver search_driver = SearchDriver::ASPIRATION; ///< Root windows
+  int endgame_empties = kDefaultEndgameEmpties; ///< Exact solve threshold
+  const OpeningBook *opening_book = nullptr; ///< Consulted before searching
+  /// Positions searched at once; 0 means one per thread of the pool
+  size_t max_parallel = 0;
+  /// Every search ends by then, whatever its own time limit; positions not
+  /// started by then are skipped
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::time_point::max();
+  /// Polled by every search alongside cancel(); once it returns true,
+  /// positions not started yet are skipped
+  StopCondition stop_condition;
+};
+
+/// @brief The answer for one position of a batch
+struct BatchResult {
+  size_t index;      ///< Position in submission order, from 0
+  GameBoard board;   ///< The position
+  Color color;       ///< The side to move
+  int best_move;     ///< -1 if there is no legal move
+  SearchStats stats; ///< Of the position's search
+};
+
+/// @brief Searches a stream of positions for bulk evaluation
+/// @details Positions are queued and searched by at most max_parallel
+///          tasks on the thread pool, each taking positions from the queue
+///          until it is empty and searching them with one engine in
+///          SearchMode::SERIAL. The batch thus works on as many positions at
+///          once as it has tasks instead of splitting each position's tree,
+///          which avoids the overhead of parallel search when there are
+///          positions enough to go round, and leaves the rest of the pool to
+///          other work. The engines share one transposition table and one
+///          endgame solver, so related positions, like the moves of one
+///          game, reuse each other's results. Positions can be submitted
+///          while earlier ones are being searched, and results are handed
+///          out as they finish, in no particular order.
+///
+///          The batch grows an engine for every task that runs at once. Use
+///          submit() and close() from one thread, and next() from one
+///          thread, which may be another; cancel() is safe from any.
+class BatchSearcher {
+ public:
+  /// @brief Constructor for BatchSearcher
+  /// @param evaluator The evaluator every engine uses
+  /// @param thread_pool The pool the positions are searched on
+  /// @param options The batch's table size and search settings
+  BatchSearcher(const Evaluator &evaluator, utils::ThreadPool &thread_pool,
+                const BatchOptions &options);
+
+  /// @brief Constructor for a BatchSearcher that searches with existing
+  ///        tables instead of allocating its own
+  /// @details For example an idle engine's, which then stay warm from one
+  ///          batch to the next. options.tt_size_mb is ignored. Nothing else
+  ///          may search with the tables while the batch lives, and they must
+  ///          outlive it.
+  /// @param shared_table The transposition table
+  /// @param shared_solver The endgame solver, with its own table
+  BatchSearcher(const Evaluator &evaluator, utils::ThreadPool &thread_pool,
+                const BatchOptions &options, TranspositionTable &shared_table,
+                EndgameSolver &shared_solver);
+
+  /// @brief Cancels the positions still queued and waits for the running
+  ///        ones
+  ~BatchSearcher();
+
+  BatchSearcher(const BatchSearcher &) = delete;
+  BatchSearcher &operator=(const BatchSearcher &) = delete;
+
+  /// @brief Queue a position
+  /// @param board The position, with color to move
+  /// @param max_depth The search's depth limit
+  /// @param time_limit_ms The search's time limit
+  /// @return The position's index
+  size_t submit(const GameBoard &board, Color color, uint8_t max_depth,
+                int time_limit_ms);
+
+  /// @brief Declare that no more positions will be submitted
+  void close();
+
+  /// @brief Stop the running searches and skip the queued positions
+  /// @details Positions not finished yet produce no result.
+  void cancel();
+
+  /// @brief Wait for the next position to finish
+  /// @return Its result, or std::nullopt once the batch is closed and
+  ///         every position has been handed out or cancelled
+  std::optional<BatchResult> next();
+
+  /// @brief Return the number of positions searched so far
+  size_t completed() const;
+
+  /// @brief Return positions searched per second since the first was
+  ///        submitted, or 0 before any
+  double positionsPerSecond() const;
+
+ private:
+  /// @brief One queued position
+  struct Job {
+    size_t index;
+    GameBoard board;
+    Color color;
+    uint8_t max_depth;
+    int time_limit_ms;
+  };
+
+  /// @brief Constructor behind both public ones: the owned tables are used
+  ///        unless shared ones are given
+  BatchSearcher(const Evaluator &evaluator, utils::ThreadPool &thread_pool,
+                const BatchOptions &options,
+                std::unique_ptr<TranspositionTable> own_table,
+                std::unique_ptr<EndgameSolver> own_solver,
+                TranspositionTable *shared_table, EndgameSolver *shared_solver);
+
+  /// @brief Search queued positions on the calling thread until the queue is
+  ///        empty, then hand slot back
+  /// @details Inside ThreadPool::wait(), searches one position and spawns
+  ///          slot again for the rest, so that the wait is not held up by
+  ///          the whole batch.
+  /// @param slot The task running this
+  void drain(utils::Task &slot);
+
+  /// @brief Search one position on the calling thread and queue its result
+  void search(const Job &job);
+
+  /// @brief Return whether the batch was cancelled or its stop condition
+  ///        holds
+  bool stopped() const;
+
+  /// @brief Take an idle engine, making one if every engine is busy
+  Engine *acquireEngine();
+
+  utils::ThreadPool &thread_pool;
+  const Evaluator &evaluator;
+  const BatchOptions options;
+
+  std::unique_ptr<TranspositionTable> owned_table; ///< Unless shared
+  TranspositionTable &table;
+  std::unique_ptr<EndgameSolver> owned_solver; ///< Unless shared
+  EndgameSolver &solver;
+
+  std::atomic<bool> cancelled{false};
+  const StopCondition stop_condition; ///< Calls stopped()
+
+  mutable std::mutex mutex;
+  std::condition_variable result_ready;
+  std::vector<std::unique_ptr<Engine>> engines;
+  std::vector<Engine *> idle; ///< Engines not searching
+  std::deque<Job> queue;      ///< Submitted, not yet taken by a task
+  /// max_parallel slots, each running drain(); a slot is spawned again once
+  /// its last run has handed it back or by that run itself, even if that run
+  /// is still returning
+  std::vector<utils::Task> tasks;
+  std::vector<utils::Task *> free_tasks; ///< Slots not draining
+  utils::TaskGroup group;
+  std::deque<BatchResult> results; ///< Finished, not yet handed out
+  size_t submitted = 0;
+  size_t finished = 0; ///< Searched or skipped
+  size_t searched = 0;
+  bool closed = false;
+  std::chrono::steady_clock::time_point started;
+};
+
+} // namespace othello
@@ -4,9 +4,11 @@
 
 #pragma once
 
+#include <optional>
 #include <set>
 #include "Engine.hpp"  // For Engine
 #include "GameBoard.hpp"
+#include "TimeManager.hpp"
 
 namespace othello {
 /// @brief Controller class for managing user input and game state
@@ -22,11 +24,20 @@ class Controller {
   /// @param time_limit_ms The time limit for the engine in milliseconds
   void startGame(int depth, int time_limit_ms);
 
+  /// @brief Starts the game loop with a game clock for each side
+  /// @param depth The maximum search depth for the engine
+  /// @param clock Each side's starting clock; every move's budget is
+  ///        allocated from what is left of it
+  void startGame(int depth, const GameClock &clock);
+
  private:
   Engine &engine;  ///< The game engine for Othello
 
   GameBoard board;  ///< The current game board
 
+  /// @brief Plays the game with a flat time limit or game clocks
+  void play(int depth, int time_limit_ms, std::optional<GameClock> clock);
+
   /// @brief Handles user input for the game
   int handleUserInput(const std::set<int> &possible_moves);
 
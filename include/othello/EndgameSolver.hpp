@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Alex Li
+// EndgameSolver.hpp
+// Exact endgame solver: searches every line to the end of the game and
+// returns the final disc differential.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+
+#include "TranspositionTable.hpp"
+
+namespace othello {
+
+/// Number of empty squares at or below which the engine solves exactly
+inline constexpr int kDefaultEndgameEmpties = 18;
+
+/// Default size of the solver's own transposition table
+inline constexpr size_t kDefaultEndgameTTSizeMB = 16;
+
+/// Largest possible magnitude of an exact score
+inline constexpr int kMaxEndgameScore = 64;
+
+/// @brief Polled while a solve runs; returning true abandons it
+using SolveAbort = std::function<bool()>;
+
+/// @brief Exact solver for positions close to the end of the game
+/// @details Scores are final disc differentials from the side to move's
+///          perspective, with empty squares awarded to the winner, so they lie
+///          in [-64, 64]. Far from the end the solver orders moves
+///          fastest-first (fewest opponent replies) and caches results in its
+///          own transposition table. With few empties left it switches to
+///          parity-ordered searches without the table, and the last four
+///          empties are handled by dedicated kernels that work on a fixed
+///          list of squares and never allocate. solve() may be called from
+///          several threads at once; they share the table.
+class EndgameSolver {
+ public:
+  /// @brief Constructor for EndgameSolver
+  /// @param tt_size_mb The size of the solver's transposition table
+  explicit EndgameSolver(size_t tt_size_mb = kDefaultEndgameTTSizeMB);
+
+  EndgameSolver(const EndgameSolver &) = delete;
+  EndgameSolver &operator=(const EndgameSolver &) = delete;
+
+  /// @brief Solve a position within a window
+  /// @param player The discs of the side to move
+  /// @param opponent The discs of the other side
+  /// @param alpha Lower bound of the window
+  /// @param beta Upper bound of the window
+  /// @param nodes Incremented by the number of nodes visited
+  /// @param abort If set, polled every kAbortPollNodes nodes; once it
+  ///        returns true the solve unwinds without storing anything more,
+  ///        and its result is meaningless
+  /// @return The exact score if it lies strictly inside (alpha, beta),
+  ///         otherwise a bound on it (fail-soft)
+  int solve(uint64_t player, uint64_t opponent, int alpha, int beta,
+            uint64_t &nodes, const SolveAbort &abort = {});
+
+  /// Nodes a solve visits between polls of its abort condition
+  static constexpr uint64_t kAbortPollNodes = 1024;
+
+  /// @brief Start a new search generation so older entries age out
+  void newSearch() { tt.newSearch(); }
+
+  /// @brief Erase every cached result. Not safe during a solve.
+  void clear() { tt.clear(); }
+
+ private:
+  /// @brief Abort polling state of one solve() call
+  struct AbortPoll {
+    const SolveAbort &abort;
+    uint64_t next_poll; ///< Node count at which abort is polled next
+    bool aborted = false;
+  };
+
+  /// @brief Fastest-first search with transposition table, used while more
+  ///        than kShallowEmpties squares are empty
+  /// @param moves The player's legal moves, which the caller has generated
+  ///        already to order its own moves
+  /// @param poll Checked before every node; the shallow searches below it
+  ///        are small enough to finish
+  int searchDeep(uint64_t player, uint64_t opponent, uint64_t moves, int alpha,
+                 int beta, uint64_t &nodes, AbortPoll &poll);
+
+  TranspositionTable tt;
+};
+
+} // namespace othello
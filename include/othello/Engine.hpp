@@ -6,40 +6,116 @@
 #pragma once
 
 #include "../utils/ThreadPool.hpp"
+#include "EndgameSolver.hpp"
 #include "GameBoard.hpp"
+#include "MoveList.hpp"
+#include "OpeningBook.hpp"
+#include "TimeManager.hpp"
+#include "TranspositionTable.hpp"
 #include "evaluator/Evaluator.hpp"
+#include <array>
 #include <atomic>
+#include <chrono>
+#include <cstddef>
 #include <cstdint>
-#include <unordered_map>
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string_view>
+#include <thread>
+#include <utility>
+#include <vector>
 
 namespace othello {
 
-/// @brief Represents the type of bound for a transposition table entry
-/// @details This enum is used to indicate whether the score is an exact score,
-/// a lower bound, or an upper bound.
-enum class BoundType : uint8_t {
-  EXACT, ///< Exact score
-  LOWER, ///< Lower bound
-  UPPER  ///< Upper bound
+/// @brief Parallel search strategy used by the engine
+enum class SearchMode : uint8_t {
+  YBWC,     ///< Root and below-root split points (Young Brothers Wait)
+  LAZY_SMP, ///< Independent iterative deepening per thread over a shared TT
+  SERIAL,   ///< The calling thread only, for running many searches at once
 };
 
-/// @brief Represents a transposition table entry
-/// @details score is stored as an integer with positive values for black
-/// winning and negative values for white winning.
-struct TTEntry {
-  int score;            ///< The score of the position (4 bytes)
-  uint8_t depth;            ///< The depth at which the position was evaluated (2 bytes)
-  BoundType bound_type; ///< The type of bound (exact, lower, upper) (1 byte)
-  int8_t move_index;       ///< The index of the move that led to this position (1 byte)
-}; ///< Total size: 8 bytes
+/// @brief Parse a search mode name ("ybwc", "lazysmp" or "serial")
+/// @return The matching mode, or std::nullopt if the name is unknown
+inline std::optional<SearchMode> parseSearchMode(std::string_view name) {
+  if (name == "ybwc") {
+    return SearchMode::YBWC;
+  }
+  if (name == "lazysmp") {
+    return SearchMode::LAZY_SMP;
+  }
+  if (name == "serial") {
+    return SearchMode::SERIAL;
+  }
+  return std::nullopt;
+}
+
+/// @brief How each iterative deepening iteration chooses its root windows
+enum class SearchDriver : uint8_t {
+  FULL_WINDOW, ///< Every iteration searches (-INF, INF)
+  ASPIRATION,  ///< A window around the previous score, widened on failure
+  MTDF,        ///< A series of zero-window searches converging on the score
+};
+
+/// @brief Parse a search driver name ("full", "aspiration" or "mtdf")
+/// @return The matching driver, or std::nullopt if the name is unknown
+inline std::optional<SearchDriver> parseSearchDriver(std::string_view name) {
+  if (name == "full") {
+    return SearchDriver::FULL_WINDOW;
+  }
+  if (name == "aspiration") {
+    return SearchDriver::ASPIRATION;
+  }
+  if (name == "mtdf") {
+    return SearchDriver::MTDF;
+  }
+  return std::nullopt;
+}
+
+/// Default for Engine::setCanonicalDiscs()
+inline constexpr int kDefaultCanonicalDiscs = 8;
+
+/// @brief Polled while a search runs; returning true stops it
+/// @details Called from every searching thread, so it must be thread-safe.
+using StopCondition = std::function<bool()>;
+
+/// @brief One root move of a multi-PV analysis
+struct RootLine {
+  int move;
+  int score; ///< Exact, for the side to move
+  std::vector<int> principal_variation; ///< Starts with move; -1 is a pass
+};
+
+/// @brief Progress of a search after one completed iteration
+struct IterationReport {
+  int depth;
+  int best_move;
+  int score; ///< For the side to move
+  std::vector<int> principal_variation; ///< From the root; -1 is a pass
+  uint64_t nodes_searched; ///< Since the search started
+  uint64_t cache_hits;
+  double elapsed_ms;
+  bool solved; ///< The scores are exact final results (x100)
+  std::vector<RootLine> lines; ///< Best first; analyzeRootMoves() only
+};
+
+/// @brief Called by the thread running findBestMove after every completed
+///        iteration; the search waits for it to return
+using IterationCallback = std::function<void(const IterationReport &)>;
 
 struct SearchStats {
-  int nodes_searched = 0;
+  uint64_t nodes_searched = 0;
   int cache_hits = 0;
   int best_move = -1;
   int score = 0;
   int completed_depth = 0;
   bool time_limit_hit = false;
+  bool solved = false; ///< Score is the exact final result (x100)
+  uint64_t cutoffs = 0;            ///< Beta cutoffs in interior nodes
+  uint64_t first_move_cutoffs = 0; ///< Cutoffs caused by the first move tried
+  int root_searches = 0; ///< Root searches, including window re-searches
+  bool book_hit = false; ///< The move came from the opening book
+  bool stopped = false;  ///< Cut short by stop() or the stop condition
 };
 
 /// @brief Represents the game engine for Othello
@@ -50,43 +126,444 @@ public:
   /// @brief Constructor for Engine
   /// @param evaluator The evaluator to use for scoring the board
   /// @param thread_pool The thread pool to use for parallelizing the search
-  Engine(const Evaluator &evaluator, utils::ThreadPool &thread_pool)
-      : nodesSearched(0), cacheHits(0), thread_pool(thread_pool),
-        evaluator(evaluator) {}
+  /// @param tt_size_mb The size of the transposition table in megabytes
+  Engine(const Evaluator &evaluator, utils::ThreadPool &thread_pool,
+         size_t tt_size_mb = kDefaultTTSizeMB)
+      : nodesSearched(0), cacheHits(0),
+        owned_table(std::make_unique<TranspositionTable>(tt_size_mb)),
+        transposition_table(*owned_table),
+        owned_solver(std::make_unique<EndgameSolver>()),
+        endgame_solver(*owned_solver), contexts(thread_pool.size() + 1),
+        thread_pool(thread_pool), evaluator(evaluator),
+        incremental_eval(evaluator.incremental()) {}
+
+  /// @brief Constructor for an engine that shares its tables with others
+  /// @details For engines searching related positions side by side, each
+  ///          on its own thread, that should reuse each other's results.
+  ///          Both tables are safe to share between concurrent searches and
+  ///          must outlive the engine.
+  /// @param shared_table The transposition table
+  /// @param shared_solver The endgame solver, with its own table
+  Engine(const Evaluator &evaluator, utils::ThreadPool &thread_pool,
+         TranspositionTable &shared_table, EndgameSolver &shared_solver)
+      : nodesSearched(0), cacheHits(0), transposition_table(shared_table),
+        endgame_solver(shared_solver), contexts(thread_pool.size() + 1),
+        thread_pool(thread_pool), evaluator(evaluator),
+        incremental_eval(evaluator.incremental()) {}
+
   /// @brief Finds the best move for the current player
   /// @param board The current game board
   /// @param max_depth The search depth for the negamax algorithm
   /// @param color The color of the player to move
   /// @param prev_passed Whether the previous player passed their turn
   /// @param time_limit_ms The time limit for the search in milliseconds
+  /// @param stop_condition If set, polled alongside the clock; the search
+  ///        stops once it returns true
   /// @return The index  of the best move found or -1 if
   ///         no valid moves are available.
+  /// @details Every searching thread checks the clock and the stop condition
+  ///          each kStopPollNodes nodes, so the time limit holds inside an
+  ///          iteration too. A search cut short returns the best move of the
+  ///          last completed iteration, or that of the interrupted one if it
+  ///          had already proved another move better; if not even the first
+  ///          iteration completed, the first move in search order.
+  ///          Positions in the opening book are answered from it without
+  ///          searching. Positions with at most endgameEmpties() empty
+  ///          squares are solved exactly instead, like solveEndgame(),
+  ///          ignoring max_depth but not the limits: a solve cut short
+  ///          returns the best move among those it finished, or the first
+  ///          move in heuristic order if it finished none, without setting
+  ///          SearchStats::solved.
+  int findBestMove(const GameBoard &board, uint8_t max_depth, Color color,
+                   int time_limit_ms, const StopCondition &stop_condition = {});
+
+  /// @brief Finds the best move within a budget managed by time
+  /// @details As above, with time's hard limit as the time limit. Each
+  ///          iteration is reported to time, which decides whether the next
+  ///          one starts; see TimeManager.
+  /// @param on_iteration If set, receives a report of every completed
+  ///        iteration, with the principal variation read from the
+  ///        transposition table
   int findBestMove(const GameBoard &board, uint8_t max_depth, Color color,
-                   int time_limit_ms);
+                   TimeManager &time, const StopCondition &stop_condition = {},
+                   const IterationCallback &on_iteration = {});
+
+  /// @brief Score the best root moves exactly (multi-PV)
+  /// @details Iterative deepening like findBestMove, but every iteration
+  ///          searches the previous iteration's best line_count moves with
+  ///          full windows, in parallel on the thread pool, and then the
+  ///          others in parallel with windows that only prove whether they
+  ///          beat the line_count-th best score so far. Moves that do are
+  ///          scored exactly and join the lines. Positions with at most
+  ///          endgameEmpties() empty squares are solved instead, in one
+  ///          pass that the limits can cut short, with lines scored like
+  ///          solveEndgame(). The opening book and the search mode are not
+  ///          used. Limits, the stop condition and on_iteration work as in
+  ///          findBestMove; each report carries the lines.
+  /// @param line_count The number of lines; values from the number of
+  ///        legal moves up score every move
+  /// @return The lines of the last completed iteration, best first, or
+  ///         none if there is no legal move or no iteration completed
+  std::vector<RootLine> analyzeRootMoves(
+      const GameBoard &board, uint8_t max_depth, Color color,
+      size_t line_count, TimeManager &time,
+      const StopCondition &stop_condition = {},
+      const IterationCallback &on_iteration = {});
+
+  /// @brief Stop the running findBestMove as soon as possible
+  /// @details The search returns as if its time limit had run out. Safe to
+  ///          call from any thread; searches started afterwards are not
+  ///          affected.
+  void stop() { search_stop.cutoff.store(true, std::memory_order_relaxed); }
+
+  /// Nodes each thread searches between checks of the clock and the stop
+  /// condition
+  static constexpr uint32_t kStopPollNodes = 1024;
+
+  /// @brief Find the best move by searching to the end of the game
+  /// @details Root moves after the first are solved in parallel on the
+  ///          thread pool, unless the search mode is SearchMode::SERIAL.
+  ///          lastSearchStats().score holds the final disc differential for
+  ///          color, scaled by 100 like terminal scores in the heuristic
+  ///          search, and completed_depth the number of empties.
+  /// @param board The current game board
+  /// @param color The color of the player to move
+  /// @return The index of a move achieving the best final result, or -1 if
+  ///         no valid moves are available
+  int solveEndgame(const GameBoard &board, Color color);
+
+  /// @brief Forget everything learned in previous searches
+  /// @details The transposition table persists across findBestMove calls so
+  ///          consecutive moves of a game reuse earlier work. Call this when
+  ///          starting an unrelated game. Must not run concurrently with a
+  ///          search, including those of engines sharing the tables.
+  void newGame();
+
+  /// @brief The transposition table the engine searches with, owned or
+  ///        shared
+  TranspositionTable &transpositionTable() { return transposition_table; }
+
+  /// @brief The endgame solver the engine solves with, owned or shared
+  EndgameSolver &endgameSolver() { return endgame_solver; }
 
   void setVerbose(bool enabled) { verbose = enabled; }
 
+  /// @brief Select the parallel search strategy for subsequent searches
+  void setSearchMode(SearchMode mode) { search_mode = mode; }
+
+  SearchMode searchMode() const { return search_mode; }
+
+  /// @brief Cap the number of Lazy SMP helper tasks a search spawns
+  /// @details Defaults to the size of the thread pool. Engines sharing a
+  ///          pool should split it between them, or one search occupies every
+  ///          worker until it finishes.
+  void setHelperThreads(size_t count) { helper_threads = count; }
+
+  size_t helperThreads() const { return helper_threads; }
+
+  /// @brief Select how iterations choose their root windows
+  void setSearchDriver(SearchDriver driver) { search_driver = driver; }
+
+  SearchDriver searchDriver() const { return search_driver; }
+
+  /// @brief Set the number of empties at or below which findBestMove solves
+  ///        the position exactly; 0 disables the switch
+  void setEndgameEmpties(int empties) { endgame_empties = empties; }
+
+  int endgameEmpties() const { return endgame_empties; }
+
+  /// @brief Answer book positions from book instead of searching them
+  /// @param book The book to consult, or nullptr to always search; must
+  ///        outlive its use by the engine
+  void setOpeningBook(const OpeningBook *book) { opening_book = book; }
+
+  /// @brief Key positions with at most discs discs by their canonical form
+  ///        in the transposition table, so mirror images share an entry
+  /// @details Symmetric transpositions only happen in the opening, where
+  ///          the board is still nearly symmetric; elsewhere the extra
+  ///          hashing is wasted. 0 disables canonical keys.
+  void setCanonicalDiscs(int discs) { canonical_discs = discs; }
+
+  int canonicalDiscs() const { return canonical_discs; }
+
+  /// @brief Enable or disable killer and history move ordering
+  void setHistoryHeuristics(bool enabled) { use_history = enabled; }
+
   SearchStats lastSearchStats() const { return last_stats; }
 
 private:
-  std::atomic<int>
+  std::atomic<uint64_t>
       nodesSearched; ///< Number of nodes searched in the search tree
 
   std::atomic<int>
       cacheHits; ///< Number of cache hits in the transposition table
 
+  /// The tables, if the engine does not share them
+  std::unique_ptr<TranspositionTable> owned_table;
+
+  /// Transposition table shared by every root worker. Allocated once for the
+  /// lifetime of the engine.
+  TranspositionTable &transposition_table;
+
+  std::unique_ptr<EndgameSolver> owned_solver;
+
+  /// Exact solver used once few enough squares are empty; keeps its own
+  /// transposition table
+  EndgameSolver &endgame_solver;
+
+  std::atomic<uint64_t> cutoffs{0};          ///< Beta cutoffs this search
+  std::atomic<uint64_t> firstMoveCutoffs{0}; ///< ... caused by the first move
+  int root_searches = 0; ///< Root searches this search, incl. re-searches
+
+  /// @brief Move ordering state of one thread
+  /// @details Killer moves are the last two moves that caused a cutoff at a
+  ///          ply; history accumulates depth^2 for every cutoff a move causes
+  ///          anywhere in the tree. Both persist across the searches of a
+  ///          game, and history is halved before every iteration so recent
+  ///          results dominate.
+  struct alignas(64) SearchContext {
+    static constexpr int kMaxPly = 64;
+
+    std::array<std::array<int8_t, 2>, kMaxPly> killers; ///< [ply][slot]
+    std::array<std::array<int32_t, 64>, 2> history;     ///< [color][square]
+    uint32_t aged_iteration = 0; ///< Iteration the history was last aged in
+    uint32_t nodes_until_poll = kStopPollNodes; ///< See pollStop()
+
+    SearchContext() { clear(); }
+
+    /// @brief Forget every killer and history score
+    void clear();
+
+    /// @brief Halve every history score
+    void age();
+
+    /// @brief Record that move caused a beta cutoff
+    void recordCutoff(int ply, Color color, int move, uint8_t depth);
+  };
+
+  /// Per-thread move ordering state: [0] belongs to the thread that called
+  /// findBestMove, [i + 1] to pool worker i
+  std::vector<SearchContext> contexts;
+
+  /// The thread currently running findBestMove
+  std::thread::id search_thread;
+
+  /// Incremented before every iterative deepening iteration
+  std::atomic<uint32_t> iteration{0};
+
+  /// @brief Return the calling thread's move ordering state, aged to the
+  ///        current iteration
+  SearchContext &threadContext();
+
+  /// Minimum remaining depth at which a node's younger brothers are searched
+  /// in parallel
+  static constexpr uint8_t kMinSplitDepth = 5;
+
+  /// @brief Shared state of a node whose moves are searched in parallel
+  /// @details Tasks below a split point check cutoff, and that of every
+  ///          ancestor split point, so work is abandoned as soon as any
+  ///          enclosing node has been refuted.
+  struct SplitPoint {
+    const SplitPoint *parent; ///< Enclosing split point, if any
+    std::atomic<int> alpha;   ///< Best score found so far by any brother
+    const int beta;           ///< Beta bound of the split node
+    std::atomic<bool> cutoff; ///< Set when a brother fails high
+    std::atomic<size_t> next_move; ///< Index of the next move to search
+
+    /// @brief Return whether this or an enclosing split point was refuted
+    bool aborted() const;
+  };
+
+  /// Root of every split point of the running search. It is never searched,
+  /// only cut off to stop the whole search, which abandons all its tasks.
+  SplitPoint search_stop{nullptr, {0}, 0, {false}, {0}};
+
+  /// When the running search runs out of time
+  std::chrono::steady_clock::time_point deadline;
+
+  /// The running search's stop condition, or nullptr
+  const StopCondition *stop_condition = nullptr;
+
+  /// @brief Cut off search_stop if the deadline has passed or the stop
+  ///        condition holds
+  void pollStop();
+
+  /// @brief solveEndgame(), abandoned once abort returns true
+  /// @details An abandoned solve sets lastSearchStats().time_limit_hit or
+  ///          stopped and returns the best root move it finished solving, or
+  ///          the first move in heuristic order if it finished none.
+  int solveEndgame(const GameBoard &board, Color color,
+                   const SolveAbort &abort);
+
+  /// @brief Forgets the search's stop condition when the search returns, by
+  ///        whichever path
+  struct StopConditionReset {
+    Engine &engine;
+    explicit StopConditionReset(Engine &engine) : engine(engine) {}
+    StopConditionReset(const StopConditionReset &) = delete;
+    StopConditionReset &operator=(const StopConditionReset &) = delete;
+    ~StopConditionReset() { engine.stop_condition = nullptr; }
+  };
+
+  /// @brief Reset the statistics, the counters and the stop state for a
+  ///        search started at start on the calling thread
+  /// @return Keep it alive until the search returns; stop_condition points
+  ///         into the caller's arguments until then
+  [[nodiscard]] StopConditionReset
+  beginSearch(std::chrono::steady_clock::time_point start,
+              const TimeManager &time, const StopCondition &stop_condition);
+
+  /// @brief A position's transposition table key
+  struct NodeKey {
+    uint64_t key;
+    int symmetry; ///< Moves are stored mapped through transform(symmetry)
+  };
+
+  /// @brief Return the key of board with color to move: its Zobrist hash,
+  ///        or a hash of its canonical form in the opening
+  NodeKey nodeKey(const GameBoard &board, Color color) const;
+
+  /// @brief Follow the transposition table's best moves from a root move
+  /// @param move The root move the line starts with
+  /// @param max_length The longest line to return, passes included
+  /// @return The line, stopping where the table has no legal move; -1 is a
+  ///         pass
+  std::vector<int> principalVariation(const GameBoard &board, Color color,
+                                      int move, int max_length) const;
+
   /// @brief Negamax search algorithm with alpha-beta pruning
   /// @param board Current game board
-  /// @param transposition_table The transposition table to use for caching
+  /// @param accumulator The board's evaluation accumulator; only maintained
+  ///        when the evaluator is incremental
   /// @param depth Current search depth
   /// @param alpha Alpha value.
   /// @param beta Beta value.
   /// @param color The color of the player to move
+  /// @param ctx The calling thread's move ordering state
+  /// @param ply Distance from the root
+  /// @param split The nearest enclosing split point, or nullptr
+  /// @param legal_moves_bb The legal moves of color if the caller already
+  ///        generated them, or kUnknownMoves
   /// @return Pair of (score, move index)
   std::pair<int, int8_t>
-  negamax(const GameBoard &board,
-          std::unordered_map<uint64_t, TTEntry> &transposition_table, uint8_t depth,
-          int alpha, int beta, Color color);
+  negamax(const GameBoard &board, const EvalAccumulator &accumulator,
+          uint8_t depth, int alpha, int beta, Color color, SearchContext &ctx,
+          int ply, const SplitPoint *split = nullptr,
+          uint64_t legal_moves_bb = kUnknownMoves);
+
+  /// @brief Derive a child's accumulator from its parent's, if the
+  ///        evaluator is incremental
+  void advance(const EvalAccumulator &parent, int move, uint64_t flips,
+               Color color, EvalAccumulator &child) const {
+    if (incremental_eval) {
+      child = parent;
+      evaluator.update(child, move, flips, color);
+    }
+  }
+
+  /// @brief Fill a root position's accumulator, if the evaluator is
+  ///        incremental
+  void resetAccumulator(const GameBoard &board,
+                        EvalAccumulator &accumulator) const {
+    if (incremental_eval) {
+      evaluator.reset(board, accumulator);
+    }
+  }
+
+  /// Half-width of the first aspiration window
+  static constexpr int kAspirationDelta = 100;
+
+  /// @brief Run one iteration with the configured driver
+  /// @param guess The previous iteration's score
+  /// @return Pair of (exact score, move) for the best root move
+  std::pair<int, int> searchIteration(const GameBoard &board,
+                                      const std::vector<int> &moves,
+                                      uint8_t depth, Color color, int guess);
+
+  /// @brief Search the root with an aspiration window around guess,
+  ///        widening the failing side in stages until the score is inside
+  std::pair<int, int> searchAspiration(const GameBoard &board,
+                                       const std::vector<int> &moves,
+                                       uint8_t depth, Color color, int guess);
+
+  /// @brief Converge on the root score with zero-window searches, starting
+  ///        from guess (MTD(f))
+  std::pair<int, int> searchMtdf(const GameBoard &board,
+                                 const std::vector<int> &moves, uint8_t depth,
+                                 Color color, int guess);
+
+  /// @brief Search every root move at one depth within (alpha, beta) with
+  ///        the root search of the configured mode
+  /// @return Pair of (score, move); the score is fail-soft. If the search
+  ///         is stopped, the move is one proved better than moves[0], or
+  ///         moves[0] itself if it completed inside the window, and -1
+  ///         otherwise.
+  std::pair<int, int> searchRoot(const GameBoard &board,
+                                 const std::vector<int> &moves, uint8_t depth,
+                                 Color color, int alpha, int beta);
+
+  /// @brief Search every root move at one depth, siblings of the first move
+  ///        in parallel on the thread pool
+  /// @return Pair of (score, move) for the best root move; the score is
+  ///         fail-soft with respect to (alpha, beta)
+  std::pair<int, int> searchRootParallel(const GameBoard &board,
+                                         const std::vector<int> &moves,
+                                         uint8_t depth, Color color, int alpha,
+                                         int beta);
+
+  /// @brief Search every root move at one depth on the calling thread
+  /// @param stop The search gives up once stop is cut off
+  /// @return Pair of (score, move) for the best root move; the score is
+  ///         fail-soft with respect to (alpha, beta)
+  std::pair<int, int> searchRootSerial(const GameBoard &board,
+                                       const std::vector<int> &moves,
+                                       uint8_t depth, Color color,
+                                       int alpha_bound, int beta,
+                                       const SplitPoint *stop);
+
+  /// @brief Run one multi-PV iteration over every root move
+  /// @param lines Every root move, in search order, with the previous
+  ///        iteration's scores; reordered best first and rescored. Only
+  ///        the first line_count scores are exact, the others are upper
+  ///        bounds.
+  /// @param solve Solve the moves exactly instead of searching to depth
+  /// @return false, leaving lines unchanged, if the search was stopped
+  bool searchRootLines(const GameBoard &board, std::vector<RootLine> &lines,
+                       uint8_t depth, Color color, size_t line_count,
+                       bool solve);
+
+  /// @brief Iterative deepening loop of one Lazy SMP helper thread
+  /// @details Only fills the shared transposition table; its root results
+  ///          are discarded. A helper picked up by a thread waiting on some
+  ///          other search's tasks returns at once instead of holding that
+  ///          search up until this one ends.
+  /// @param moves The root moves, in the main thread's order
+  /// @param helper_id 1-based helper number, used to perturb the search
+  /// @param stop Cut off by the main thread when the search is over
+  void lazySmpHelper(const GameBoard &board, std::vector<int> moves,
+                     uint8_t max_depth, Color color, size_t helper_id,
+                     const SplitPoint &stop);
+
+  /// @brief Search moves[1..] of a node in parallel (Young Brothers Wait)
+  /// @details Called after the eldest brother has been searched serially.
+  ///          The calling thread helps execute the spawned tasks while it
+  ///          waits for them.
+  /// @param board The node's game board
+  /// @param accumulator The node's evaluation accumulator
+  /// @param moves The node's ordered legal moves
+  /// @param depth The node's remaining depth
+  /// @param ply The node's distance from the root
+  /// @param alpha The node's alpha; raised to the best score found
+  /// @param beta The node's beta
+  /// @param color The color of the player to move
+  /// @param parent The split point enclosing the node, or nullptr
+  /// @param best_pair The node's best (score, move); updated in place
+  void searchSplitPoint(const GameBoard &board,
+                        const EvalAccumulator &accumulator,
+                        const MoveList &moves,
+                        uint8_t depth, int ply, int &alpha, int beta,
+                        Color color, const SplitPoint *parent,
+                        std::pair<int, int8_t> &best_pair);
 
   /// The thread pool for parallelizing the search
   utils::ThreadPool &thread_pool;
@@ -94,8 +571,25 @@ private:
   /// The evaluator to use for scoring the board
   const Evaluator &evaluator;
 
+  /// Whether the search carries evaluation accumulators (see Evaluator)
+  const bool incremental_eval;
+
   bool verbose = true;
 
+  SearchMode search_mode = SearchMode::YBWC;
+
+  size_t helper_threads = thread_pool.size(); ///< See setHelperThreads()
+
+  SearchDriver search_driver = SearchDriver::ASPIRATION;
+
+  int endgame_empties = kDefaultEndgameEmpties;
+
+  int canonical_discs = kDefaultCanonicalDiscs;
+
+  bool use_history = true;
+
+  const OpeningBook *opening_book = nullptr;
+
   SearchStats last_stats;
 };
 
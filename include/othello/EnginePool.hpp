@@ -0,0 +1,122 @@
+// Copyright (c) 2026 Alex Li
+// EnginePool.hpp
+// Fixed pool of Engine instances with a bounded FIFO admission queue, used to
+// serve concurrent search requests.
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_set>
+#include <vector>
+
+#include "../utils/ThreadPool.hpp"
+#include "EndgameSolver.hpp"
+#include "Engine.hpp"
+#include "OpeningBook.hpp"
+#include "TranspositionTable.hpp"
+#include "evaluator/Evaluator.hpp"
+
+namespace othello {
+
+/// @brief Sizing options for an EnginePool
+struct EnginePoolOptions {
+  size_t engines = 2;     ///< Maximum number of searches running at once
+  size_t max_queue = 16;  ///< Maximum number of requests waiting for an engine
+  size_t tt_size_mb = kDefaultTTSizeMB; ///< Transposition table size per engine
+  SearchMode search_mode = SearchMode::YBWC; ///< Parallel search strategy
+  SearchDriver search_driver = SearchDriver::ASPIRATION; ///< Root windows
+  int endgame_empties = kDefaultEndgameEmpties; ///< Exact solve threshold
+  const OpeningBook *opening_book = nullptr; ///< Consulted before searching
+};
+
+/// @brief Owns several engines and hands them out one request at a time
+/// @details Each engine keeps its own transposition table and search
+///          statistics, so a request that holds a lease never observes
+///          another request's state. All engines share one thread pool for
+///          their root workers; in Lazy SMP mode each engine spawns at most
+///          its share of the pool's threads as helpers. Requests that find every engine busy wait in
+///          FIFO order; once max_queue requests are already waiting, acquire()
+///          fails immediately so the caller can shed load. A waiting request
+///          that reaches its deadline or is stopped leaves the queue, and the
+///          requests behind it move up.
+class EnginePool {
+ public:
+  /// @brief Exclusive handle to one engine; returns it to the pool on
+  ///        destruction
+  class Lease {
+   public:
+    Lease(Lease &&other) noexcept
+        : pool(other.pool), engine(other.engine) {
+      other.pool = nullptr;
+      other.engine = nullptr;
+    }
+    Lease &operator=(Lease &&) = delete;
+    Lease(const Lease &) = delete;
+    Lease &operator=(const Lease &) = delete;
+    ~Lease();
+
+    Engine &operator*() const { return *engine; }
+    Engine *operator->() const { return engine; }
+
+   private:
+    friend class EnginePool;
+    Lease(EnginePool *pool, Engine *engine) : pool(pool), engine(engine) {}
+
+    EnginePool *pool;
+    Engine *engine;
+  };
+
+  /// @brief Constructor for EnginePool
+  /// @param evaluator The evaluator shared by every engine
+  /// @param thread_pool The thread pool shared by every engine
+  /// @param options Pool and queue sizing
+  EnginePool(const Evaluator &evaluator, utils::ThreadPool &thread_pool,
+             const EnginePoolOptions &options);
+
+  EnginePool(const EnginePool &) = delete;
+  EnginePool &operator=(const EnginePool &) = delete;
+
+  /// @brief Wait for a free engine
+  /// @param deadline When to stop waiting
+  /// @param stop If set, polled every kStopPollInterval while waiting; the
+  ///        wait ends once it returns true
+  /// @return A lease on an idle engine, or std::nullopt if the admission
+  ///         queue is already full or the wait ended first
+  std::optional<Lease>
+  acquire(std::chrono::steady_clock::time_point deadline =
+              std::chrono::steady_clock::time_point::max(),
+          const StopCondition &stop = {});
+
+  /// How often a waiting request polls its stop condition
+  static constexpr std::chrono::milliseconds kStopPollInterval{10};
+
+  /// @brief Return the number of leases currently held
+  size_t activeSearches() const;
+
+  /// @brief Return the number of requests waiting for an engine
+  size_t queuedRequests() const;
+
+ private:
+  void release(Engine *engine);
+
+  /// @brief Serve the next ticket, skipping those given up
+  void advanceServing();
+
+  std::vector<std::unique_ptr<Engine>> engines; ///< Every engine in the pool
+  std::vector<Engine *> idle;                   ///< Engines free to lease
+  const size_t max_queue;
+
+  mutable std::mutex mutex;
+  std::condition_variable engine_released;
+  uint64_t next_ticket = 0;   ///< Ticket handed to the next waiting request
+  uint64_t now_serving = 0;   ///< Ticket allowed to take the next engine
+  std::unordered_set<uint64_t> abandoned; ///< Tickets given up, not served
+};
+
+} // namespace othello
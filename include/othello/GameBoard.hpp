@@ -8,11 +8,13 @@
 #include <cstdint> // For uint64_t
 
 #include "Constants.hpp" // For bitboard constants
+#include "Hash.hpp"      // For ZobristTable and kDefaultZobristSeed
 
 namespace othello {
 
-using ZobristTable = std::array<std::array<uint64_t, 2>, 64>;
-
+/// Keys generated at compile time from kDefaultZobristSeed, so hashes agree
+/// across processes; initializeZobrist() can regenerate them from another
+/// seed
 extern ZobristTable zobrist_table;
 extern uint64_t zobrist_black_turn;
 
@@ -24,9 +26,16 @@ enum class Color : int8_t {
 };
 
 /// @brief Initialize the zobrist hashing table
-void initializeZobrist();
+/// @details The keys are deterministic: the default seed gives the keys
+///          compiled in, and any other seed gives the same keys in every
+///          process. Hashes computed before the call are invalidated.
+/// @param seed The seed to generate the keys from
+void initializeZobrist(uint64_t seed = kDefaultZobristSeed);
 
 /// @brief Generate a zobrist hash for the game board
+/// @details Built with OTHELLO_MIX_HASH, this is a multiply-mix of the two
+///          bitboards instead (see mixBitboards), with the same side to
+///          move key, so moves don't pay a key lookup per flipped disc.
 /// @param black_bb (uint64_t) : The bitboard for black pieces
 /// @param white_bb (uint64_t) : The bitboard for white pieces
 /// @return int : The Zobrist hash for the board state
@@ -74,4 +83,25 @@ inline Color opponent(Color c) {
 /// @param color The color of the player making the move
 /// @return A new GameBoard with the move applied
 GameBoard applyMove(const GameBoard &b, int position, Color color);
+
+/// @brief Apply the move to the game board and report the discs it flipped
+/// @param flips Receives the bitboard of the flipped discs, which excludes
+///        the square played
+GameBoard applyMove(const GameBoard &b, int position, Color color,
+                    uint64_t &flips);
+
+/// @brief Apply a move whose flips are known, for the search
+/// @details Only updates the bitboards and hash: the opponent is always to
+///          move next, even if it has no legal move. Unlike applyMove this
+///          generates no moves; the search detects passes itself when it
+///          generates the opponent's moves anyway.
+/// @param flips The discs the move flips, as returned by getFlips
+GameBoard makeMove(const GameBoard &b, int position, Color color,
+                   uint64_t flips);
+
+/// @brief Return the board with the other side to move, for a pass
+inline GameBoard passTurn(const GameBoard &b) {
+  return GameBoard(b.black_bb, b.white_bb, b.zobrist_hash ^ zobrist_black_turn,
+                   opponent(b.current_turn));
+}
 } // namespace othello
@@ -0,0 +1,60 @@
+// Copyright (c) 2026 Alex Li
+// Hash.hpp
+// Deterministic position hashing: compile-time Zobrist keys and a
+// multiply-mix of the bitboards
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace othello {
+
+using ZobristTable = std::array<std::array<uint64_t, 2>, 64>;
+
+/// Seed of the Zobrist keys compiled into the engine
+inline constexpr uint64_t kDefaultZobristSeed = 0x9E3779B97F4A7C15ULL;
+
+/// @brief Advance a SplitMix64 state and return its next output
+constexpr uint64_t splitMix64(uint64_t &state) {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ULL);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+  return z ^ (z >> 31);
+}
+
+/// @brief Zobrist keys: one per square and color, plus the side to move
+struct ZobristKeys {
+  ZobristTable squares;   ///< [square][0 = black, 1 = white]
+  uint64_t black_turn;    ///< XORed in when black is to move
+};
+
+/// @brief Generate the keys for a seed; usable at compile time
+constexpr ZobristKeys makeZobristKeys(uint64_t seed) {
+  ZobristKeys keys{};
+  uint64_t state = seed;
+  for (auto &square : keys.squares) {
+    for (uint64_t &key : square) {
+      key = splitMix64(state);
+    }
+  }
+  keys.black_turn = splitMix64(state);
+  return keys;
+}
+
+/// @brief Mix two bitboards into a 64-bit hash
+/// @details A few multiplies, shifts and a rotate, so it costs the same
+///          whatever changed between two positions. Used by the endgame
+///          solver, and for GameBoard hashes when built with
+///          OTHELLO_MIX_HASH.
+constexpr uint64_t mixBitboards(uint64_t first, uint64_t second) {
+  uint64_t h = first * 0x9E3779B97F4A7C15ULL ^
+               std::rotl(second * 0xC2B2AE3D27D4EB4FULL, 31);
+  h ^= h >> 29;
+  h *= 0xBF58476D1CE4E5B9ULL;
+  h ^= h >> 32;
+  return h;
+}
+
+} // namespace othello
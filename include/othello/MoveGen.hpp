@@ -0,0 +1,90 @@
+// Copyright (c) 2026 Alex Li
+// MoveGen.hpp
+// Move generation and flip kernels, with SIMD variants selected at startup
+
+#pragma once
+
+#include <cstdint>
+#include <optional>
+#include <string_view>
+
+namespace othello {
+
+/// @brief Instruction sets the move generation kernels are written for
+enum class SimdLevel : uint8_t {
+  SCALAR, ///< Portable 64-bit code
+  AVX2,   ///< Four directions per 256-bit vector, both ways in two chains
+  AVX512, ///< All eight directions in one 512-bit vector
+};
+
+/// @brief Parse a level name ("scalar", "avx2" or "avx512")
+/// @return The matching level, or std::nullopt if the name is unknown
+inline std::optional<SimdLevel> parseSimdLevel(std::string_view name) {
+  if (name == "scalar") {
+    return SimdLevel::SCALAR;
+  }
+  if (name == "avx2") {
+    return SimdLevel::AVX2;
+  }
+  if (name == "avx512") {
+    return SimdLevel::AVX512;
+  }
+  return std::nullopt;
+}
+
+/// @brief The name parseSimdLevel() accepts for a level
+inline std::string_view simdLevelName(SimdLevel level) {
+  switch (level) {
+  case SimdLevel::AVX2:
+    return "avx2";
+  case SimdLevel::AVX512:
+    return "avx512";
+  case SimdLevel::SCALAR:
+    break;
+  }
+  return "scalar";
+}
+
+/// @brief One implementation of move generation and flip computation
+struct MoveGenKernels {
+  SimdLevel level;
+
+  /// @brief Return the legal moves for the player owning my_board
+  uint64_t (*moves)(uint64_t my_board, uint64_t op_board);
+
+  /// @brief Return the discs flipped by playing the empty square position
+  uint64_t (*flips)(uint64_t my_board, uint64_t op_board, int position);
+};
+
+/// @brief Compute flips by walking each direction a square at a time
+/// @details The loop getFlips() used before the branchless kernels, kept as
+///          the reference they are tested and benchmarked against.
+uint64_t referenceFlips(uint64_t my_board, uint64_t op_board, int position);
+
+/// @brief Return the highest level the CPU (and OS) supports, using CPUID
+SimdLevel detectSimdLevel();
+
+/// @brief Return the kernels for a level
+/// @return nullptr if the level isn't compiled in or the CPU lacks it
+const MoveGenKernels *moveGenKernels(SimdLevel level);
+
+/// The kernels behind getMoves() and getFlips()
+extern const MoveGenKernels *active_move_gen;
+
+/// @brief Return the kernels behind getMoves() and getFlips()
+/// @details At startup these are the best the CPU supports, capped by the
+///          OTHELLO_SIMD environment variable (scalar, avx2 or avx512).
+inline const MoveGenKernels &activeMoveGen() { return *active_move_gen; }
+
+/// @brief Switch the kernels behind getMoves() and getFlips()
+/// @details Meant for benchmarks and tests; must not run during a search.
+/// @return false, leaving the kernels unchanged, if the level is unavailable
+bool selectMoveGen(SimdLevel level);
+
+/// @brief Put custom kernels behind getMoves() and getFlips()
+/// @details For instrumentation, e.g. a benchmark counting calls through
+///          wrappers around moveGenKernels(). The kernels must outlive their
+///          use and must not be swapped during a search.
+void installMoveGen(const MoveGenKernels &kernels);
+
+} // namespace othello
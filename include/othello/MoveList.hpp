@@ -0,0 +1,94 @@
+// Copyright (c) 2026 Alex Li
+// MoveList.hpp
+// Fixed-capacity list of scored moves used by the search
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <utility>
+
+namespace othello {
+
+/// Stands in for a set of legal moves that hasn't been generated; no
+/// reachable position has every square empty
+inline constexpr uint64_t kUnknownMoves = ~0ULL;
+
+/// @brief A move together with its move ordering score
+struct ScoredMove {
+  int score;     ///< Higher scores are searched first
+  int8_t square; ///< The position of the move (0-63)
+};
+
+/// @brief Stack-allocated list of the legal moves of one position
+/// @details Sized for one entry per square, so it never allocates, even for
+///          positions built by hand. Moves are taken best-first with
+///          pickNext(), which only orders as much of the list as the search
+///          actually visits before a cutoff. Ordering by mobility plays every
+///          move to count the replies; the flips and replies can be kept,
+///          indexed by square, so the search reuses them.
+class MoveList {
+ public:
+  static constexpr size_t kCapacity = 64;
+
+  /// @brief Append a move
+  void push(int square, int score) {
+    moves[count++] = {score, static_cast<int8_t>(square)};
+  }
+
+  /// @brief Append a move with the discs it flips and the replies it leaves
+  /// @details Either every move of a list is pushed this way or none is.
+  void push(int square, int score, uint64_t flips, uint64_t replies) {
+    push(square, score);
+    move_flips[square] = flips;
+    move_replies[square] = replies;
+    played = true;
+  }
+
+  /// @brief The discs a move flips, or 0 if they weren't recorded
+  uint64_t flips(int square) const { return played ? move_flips[square] : 0; }
+
+  /// @brief The opponent's legal moves after a move, or kUnknownMoves
+  uint64_t replies(int square) const {
+    return played ? move_replies[square] : kUnknownMoves;
+  }
+
+  size_t size() const { return count; }
+  bool empty() const { return count == 0; }
+
+  const ScoredMove &operator[](size_t i) const { return moves[i]; }
+
+  /// @brief Move the best-scored of moves[i..] to position i
+  /// @return The square of that move
+  int pickNext(size_t i) {
+    size_t best = i;
+    for (size_t j = i + 1; j < count; ++j) {
+      if (moves[j].score > moves[best].score) {
+        best = j;
+      }
+    }
+    std::swap(moves[i], moves[best]);
+    return moves[i].square;
+  }
+
+  /// @brief Fully order moves[i..], best first
+  void sortFrom(size_t i) {
+    for (size_t j = i + 1; j < count; ++j) {
+      const ScoredMove move = moves[j];
+      size_t k = j;
+      for (; k > i && moves[k - 1].score < move.score; --k) {
+        moves[k] = moves[k - 1];
+      }
+      moves[k] = move;
+    }
+  }
+
+ private:
+  ScoredMove moves[kCapacity];
+  size_t count = 0;
+  bool played = false; ///< Whether flips and replies were recorded
+  uint64_t move_flips[kCapacity];   ///< Indexed by square
+  uint64_t move_replies[kCapacity]; ///< Indexed by square
+};
+
+} // namespace othello
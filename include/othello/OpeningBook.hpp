@@ -0,0 +1,87 @@
+// Copyright (c) 2026 Alex Li
+// OpeningBook.hpp
+// Read-only opening book: a sorted file of searched positions, memory-mapped
+// and looked up by canonical position key
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <vector>
+
+#include "GameBoard.hpp"
+
+namespace othello {
+
+/// @brief One book position as stored in the file (little-endian)
+/// @details Positions are from the side to move's point of view and reduced
+///          to one of their eight symmetric forms, so the key and move are in
+///          that canonical orientation.
+struct BookEntry {
+  uint64_t key;    ///< Canonical position key (see OpeningBook::canonical)
+  int16_t score;   ///< Search score for the side to move, engine units
+  uint8_t move;    ///< Best move in the canonical orientation
+  uint8_t depth;   ///< Depth the move was searched to
+  uint32_t visits; ///< Times the position was reached while building
+};
+
+static_assert(sizeof(BookEntry) == 16, "book entries are 16 bytes on disk");
+
+/// @brief A book answer, in the orientation of the probed position
+struct BookMove {
+  int move;
+  int score;
+  int depth;
+  uint32_t visits;
+};
+
+/// @brief Memory-mapped opening book
+/// @details The file is a 16-byte header followed by BookEntry records sorted
+///          by key. Opening it maps the file without reading it: pages are
+///          faulted in by the lookups that touch them, so a book costs no
+///          heap memory and loads in constant time. Lookups are a binary
+///          search over the mapping and never allocate; they are safe from
+///          any number of threads.
+class OpeningBook {
+ public:
+  /// @brief A position's canonical key and the symmetry that produces it
+  struct Canonical {
+    uint64_t key;
+    int symmetry; ///< As passed to transform()
+  };
+
+  /// @brief Map a book file
+  /// @throws std::runtime_error if the file is missing or malformed
+  explicit OpeningBook(const std::string &path);
+  ~OpeningBook();
+
+  OpeningBook(const OpeningBook &) = delete;
+  OpeningBook &operator=(const OpeningBook &) = delete;
+
+  /// @brief Look up the position with color to move
+  /// @return The book move, or std::nullopt if the position isn't in the book
+  std::optional<BookMove> probe(const GameBoard &board, Color color) const;
+
+  /// @brief Number of positions in the book
+  size_t size() const { return entry_count; }
+
+  /// @brief Hash the canonical form of a position (see canonicalize())
+  /// @param player The discs of the side to move
+  /// @param opponent The discs of the other side
+  static Canonical canonical(uint64_t player, uint64_t opponent);
+
+  /// @brief Sort entries by key and write them as a book file
+  /// @throws std::runtime_error if the file cannot be written, or if two
+  ///         entries share a key
+  static void save(const std::string &path, std::vector<BookEntry> entries);
+
+ private:
+  const void *mapping = nullptr; ///< The whole file
+  size_t mapping_size = 0;
+  const BookEntry *entries = nullptr; ///< Sorted records inside the mapping
+  size_t entry_count = 0;
+};
+
+} // namespace othello
@@ -10,6 +10,19 @@
 
 namespace othello {
 
+/// @brief Return the legal moves for the player owning my_board
+/// @param my_board The bitboard of the player's discs
+/// @param op_board The bitboard of the opponent's discs
+/// @return A bitboard representing the possible moves
+uint64_t getMoves(uint64_t my_board, uint64_t op_board);
+
+/// @brief Return the discs flipped by playing position
+/// @param my_board The bitboard of the player's discs
+/// @param op_board The bitboard of the opponent's discs
+/// @param position The position of the move (0-63); must be empty
+/// @return A bitboard of the flipped discs; 0 if the move is illegal
+uint64_t getFlips(uint64_t my_board, uint64_t op_board, int position);
+
 /// @brief Return a vector of all possible move positions for the given color
 /// @param b The game board to check for possible moves
 /// @param color The color whose possible moves to check
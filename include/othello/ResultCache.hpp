@@ -0,0 +1,157 @@
+// Copyright (c) 2026 Alex Li
+// ResultCache.hpp
+// Bounded cache of search results for repeated requests, with concurrent
+// identical requests coalesced onto one search
+
+#pragma once
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <unordered_map>
+#include <vector>
+
+#include "GameBoard.hpp"
+
+namespace othello {
+
+/// @brief The answer to a search request
+struct CachedSearch {
+  int best_move;  ///< -1 if there is no legal move
+  int eval_score; ///< Static evaluation reported with the move
+  int search_score = 0;  ///< The search's score reported with the move
+  bool solved = false;   ///< search_score is exact
+  bool cacheable = true; ///< False if the search was cut short
+};
+
+/// @brief How long a ResultCache request waits for an identical request's
+///        search
+struct WaitLimit {
+  std::chrono::steady_clock::time_point deadline =
+      std::chrono::steady_clock::time_point::max();
+  /// If set, polled every ResultCache::kStopPollInterval; the wait ends once
+  /// it returns true
+  std::function<bool()> stop;
+};
+
+/// @brief Result cache with CLOCK replacement and single-flight misses
+/// @details Entries are keyed by the position in its canonical orientation
+///          (see canonicalize()), the side to move, the depth limit and the
+///          time limit rounded to a power of two, so mirrored positions and
+///          nearby time limits share an entry. A miss runs the caller's
+///          search; identical requests arriving meanwhile wait for that
+///          search instead of starting their own, for as long as their own
+///          wait limit allows. Failed searches, and results the search marks
+///          as not cacheable, are never cached, and a waiting request does
+///          not take them either: it runs its own search, or waits for the
+///          next identical request's. The number of entries is fixed by a
+///          memory budget, and CLOCK evicts the first entry not hit since the
+///          hand last passed it. Safe to use from any number of threads.
+class ResultCache {
+ public:
+  /// @brief How a lookup was answered
+  enum class Outcome : uint8_t {
+    HIT,       ///< From the cache
+    MISS,      ///< By running the search
+    COALESCED, ///< By waiting for an identical request's search
+    GAVE_UP,   ///< Not at all: the wait limit ran out first
+  };
+
+  /// How often a waiting request polls its stop predicate
+  static constexpr std::chrono::milliseconds kStopPollInterval{10};
+
+  /// @brief Counters since construction
+  struct Stats {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t coalesced = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t capacity = 0;
+  };
+
+  /// @brief Search run on a miss; std::nullopt reports a failure
+  using Search = std::function<std::optional<CachedSearch>()>;
+
+  /// @brief Constructor for ResultCache
+  /// @param budget_bytes Memory the entries and their index may use; 0
+  ///        disables caching but still coalesces identical requests
+  explicit ResultCache(size_t budget_bytes);
+
+  ResultCache(const ResultCache &) = delete;
+  ResultCache &operator=(const ResultCache &) = delete;
+
+  /// @brief Answer a request from the cache, from an identical request in
+  ///        flight, or by running search
+  /// @param board The position, with color to move
+  /// @param depth The request's depth limit
+  /// @param time_limit_ms The request's time limit
+  /// @param search Runs the search on a miss
+  /// @param outcome If not nullptr, receives how the request was answered
+  /// @param wait_limit Bounds any wait for an identical request's search;
+  ///        the request's own search is bounded by search itself
+  /// @return The result, or std::nullopt if the search failed or the wait
+  ///         limit ran out
+  std::optional<CachedSearch> lookup(const GameBoard &board, Color color,
+                                     uint8_t depth, int time_limit_ms,
+                                     const Search &search,
+                                     Outcome *outcome = nullptr,
+                                     const WaitLimit &wait_limit = {});
+
+  Stats stats() const;
+
+  /// @brief Return the number of entries the budget allows
+  size_t capacity() const { return slot_capacity; }
+
+ private:
+  struct Key {
+    uint64_t black_bb; ///< Canonical orientation
+    uint64_t white_bb;
+    Color color;
+    uint8_t depth;
+    uint8_t time_bucket; ///< std::bit_width of the time limit
+
+    bool operator==(const Key &) const = default;
+  };
+
+  struct KeyHash {
+    size_t operator()(const Key &key) const;
+  };
+
+  struct Slot {
+    Key key;
+    CachedSearch result; ///< best_move in the canonical orientation
+    bool referenced;     ///< Hit since the clock hand last passed
+  };
+
+  /// @brief A search in progress that identical requests wait for
+  struct Flight {
+    bool done = false;
+    std::optional<CachedSearch> result; ///< Canonical orientation
+    std::condition_variable finished;
+  };
+
+  /// @brief Wait with lock held until flight is done
+  /// @return false if wait_limit ran out first
+  static bool waitFor(std::unique_lock<std::mutex> &lock, Flight &flight,
+                      const WaitLimit &wait_limit);
+
+  /// @brief Store a result, evicting with the clock hand once full
+  void insert(const Key &key, const CachedSearch &result);
+
+  const size_t slot_capacity;
+
+  mutable std::mutex mutex;
+  std::vector<Slot> slots;
+  size_t hand = 0; ///< Next slot the clock considers for eviction
+  std::unordered_map<Key, size_t, KeyHash> index; ///< Key to slot
+  std::unordered_map<Key, std::shared_ptr<Flight>, KeyHash> in_flight;
+  Stats counters;
+};
+
+} // namespace othello
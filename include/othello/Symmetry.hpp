@@ -0,0 +1,124 @@
+// Copyright (c) 2026 Alex Li
+// Symmetry.hpp
+// Bitboard transforms for the eight symmetries of the Othello board
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+namespace othello {
+
+/// @brief Mirror the board top to bottom (row r becomes row 7 - r)
+constexpr uint64_t flipVertical(uint64_t bb) { return std::byteswap(bb); }
+
+/// @brief Mirror the board left to right (column c becomes column 7 - c)
+constexpr uint64_t flipHorizontal(uint64_t bb) {
+  constexpr uint64_t k1 = 0x5555555555555555ULL;
+  constexpr uint64_t k2 = 0x3333333333333333ULL;
+  constexpr uint64_t k4 = 0x0F0F0F0F0F0F0F0FULL;
+  bb = ((bb >> 1) & k1) | ((bb & k1) << 1);
+  bb = ((bb >> 2) & k2) | ((bb & k2) << 2);
+  bb = ((bb >> 4) & k4) | ((bb & k4) << 4);
+  return bb;
+}
+
+/// @brief Mirror the board along the main diagonal (square (r, c) becomes
+///        (c, r)), using three delta swaps
+constexpr uint64_t flipDiagonal(uint64_t bb) {
+  constexpr uint64_t k1 = 0x5500550055005500ULL;
+  constexpr uint64_t k2 = 0x3333000033330000ULL;
+  constexpr uint64_t k4 = 0x0F0F0F0F00000000ULL;
+  uint64_t t = k4 & (bb ^ (bb << 28));
+  bb ^= t ^ (t >> 28);
+  t = k2 & (bb ^ (bb << 14));
+  bb ^= t ^ (t >> 14);
+  t = k1 & (bb ^ (bb << 7));
+  bb ^= t ^ (t >> 7);
+  return bb;
+}
+
+/// Number of symmetries of the board
+inline constexpr int kSymmetries = 8;
+
+/// @brief Apply one of the eight board symmetries
+/// @param bb The bitboard to transform
+/// @param symmetry Bit 0 mirrors left to right, bit 1 mirrors top to bottom,
+///        and bit 2 then mirrors along the main diagonal
+constexpr uint64_t transform(uint64_t bb, int symmetry) {
+  if (symmetry & 1) {
+    bb = flipHorizontal(bb);
+  }
+  if (symmetry & 2) {
+    bb = flipVertical(bb);
+  }
+  if (symmetry & 4) {
+    bb = flipDiagonal(bb);
+  }
+  return bb;
+}
+
+/// @brief Undo transform(bb, symmetry), applying its mirrors in reverse
+constexpr uint64_t untransform(uint64_t bb, int symmetry) {
+  if (symmetry & 4) {
+    bb = flipDiagonal(bb);
+  }
+  if (symmetry & 2) {
+    bb = flipVertical(bb);
+  }
+  if (symmetry & 1) {
+    bb = flipHorizontal(bb);
+  }
+  return bb;
+}
+
+/// @brief Map a square through transform()
+constexpr int transformSquare(int square, int symmetry) {
+  return std::countr_zero(transform(1ULL << square, symmetry));
+}
+
+/// @brief Map a square through untransform()
+constexpr int untransformSquare(int square, int symmetry) {
+  return std::countr_zero(untransform(1ULL << square, symmetry));
+}
+
+/// @brief A pair of bitboards in its canonical orientation
+struct CanonicalBoards {
+  uint64_t first;
+  uint64_t second;
+  int symmetry; ///< The transform() that produced them from the originals
+};
+
+/// @brief Reduce a pair of bitboards (black and white, or player and
+///        opponent) to the symmetric form with the smallest (first, second)
+/// @details All symmetric positions reduce to the same pair, so it can key
+///          any table that should treat mirror images as one position. The
+///          eight forms are built from one left-right mirror, two byte swaps
+///          and four diagonal mirrors per board.
+constexpr CanonicalBoards canonicalize(uint64_t first, uint64_t second) {
+  std::array<uint64_t, kSymmetries> firsts{};
+  std::array<uint64_t, kSymmetries> seconds{};
+  firsts[0] = first;
+  seconds[0] = second;
+  firsts[1] = flipHorizontal(first);
+  seconds[1] = flipHorizontal(second);
+  for (int symmetry = 2; symmetry < 4; ++symmetry) {
+    firsts[symmetry] = flipVertical(firsts[symmetry - 2]);
+    seconds[symmetry] = flipVertical(seconds[symmetry - 2]);
+  }
+  for (int symmetry = 4; symmetry < kSymmetries; ++symmetry) {
+    firsts[symmetry] = flipDiagonal(firsts[symmetry - 4]);
+    seconds[symmetry] = flipDiagonal(seconds[symmetry - 4]);
+  }
+  CanonicalBoards best{first, second, 0};
+  for (int symmetry = 1; symmetry < kSymmetries; ++symmetry) {
+    if (firsts[symmetry] < best.first ||
+        (firsts[symmetry] == best.first && seconds[symmetry] < best.second)) {
+      best = {firsts[symmetry], seconds[symmetry], symmetry};
+    }
+  }
+  return best;
+}
+
+} // namespace othello
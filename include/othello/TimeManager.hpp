@@ -0,0 +1,84 @@
+// Copyright (c) 2026 Alex Li
+// TimeManager.hpp
+// Per-move time budgets from a game clock, and the decision whether another
+// iterative deepening iteration fits in them.
+
+#pragma once
+
+#include <array>
+#include <cstdint>
+
+namespace othello {
+
+/// @brief The side to move's game clock
+struct GameClock {
+  int remaining_ms; ///< Time left for the rest of the game
+  int increment_ms; ///< Time added after every move
+};
+
+/// @brief Time allowed for one move
+struct MoveBudget {
+  int soft_ms; ///< No iteration starts after this (before stability scaling)
+  int hard_ms; ///< The search is stopped here, even inside an iteration
+};
+
+/// @brief Decides how long one search may take
+/// @details allocate() splits a game clock into per-move budgets, giving
+///          midgame moves more than opening and late moves. The engine
+///          reports every completed iteration, and the manager decides
+///          whether the next one is worth starting: not after the soft limit,
+///          which shrinks while the best move stays the same and grows when
+///          it just changed, and not if the iteration is predicted to run
+///          past the hard limit. The prediction scales the last iteration by
+///          the observed effective branching factor: the larger of the last
+///          growth and the growth between the previous two iterations, since
+///          odd and even depths differ in cost. Iterations answered from the
+///          transposition table predict nothing, so the first one that
+///          searches in earnest is only bounded by the hard limit.
+class TimeManager {
+ public:
+  /// @brief Split a game clock into a budget for the next move
+  /// @param clock The side to move's clock
+  /// @param empties Empty squares on the board, which bound the number of
+  ///        moves still to play
+  static MoveBudget allocate(const GameClock &clock, int empties);
+
+  /// @brief Manage one search
+  /// @param budget The search's limits, from the search's start
+  /// @param adaptive If false, iterations start until the hard limit
+  ///        whatever they are predicted to cost, like a flat time limit
+  explicit TimeManager(MoveBudget budget, bool adaptive = true)
+      : move_budget(budget), adaptive(adaptive) {}
+
+  const MoveBudget &budget() const { return move_budget; }
+
+  /// @brief Record a completed iteration
+  /// @param best_move The iteration's best move
+  /// @param nodes Nodes searched by the iteration
+  /// @param elapsed_ms Time since the search started
+  void iterationCompleted(int best_move, uint64_t nodes, double elapsed_ms);
+
+  /// @brief Return whether to start another iteration elapsed_ms into the
+  ///        search
+  bool startIteration(double elapsed_ms) const;
+
+  /// @brief Return the soft limit scaled by best-move stability
+  double softLimitMs() const;
+
+  /// @brief Return the predicted duration of the next iteration, or 0
+  ///        before any iteration has completed
+  double predictedIterationMs() const;
+
+ private:
+  MoveBudget move_budget;
+  bool adaptive;
+
+  int iterations = 0; ///< Completed iterations
+  int best_move = -1;
+  int stable_iterations = 0; ///< Iterations since the best move last changed
+  double completed_at_ms = 0; ///< When the last iteration completed
+  double last_iteration_ms = 0;
+  std::array<uint64_t, 3> nodes{}; ///< Of the last iterations, newest first
+};
+
+} // namespace othello
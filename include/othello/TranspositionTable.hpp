@@ -0,0 +1,117 @@
+// Copyright (c) 2026 Alex Li
+// TranspositionTable.hpp
+// Fixed-size, cache-line-bucketed transposition table shared by all search
+// threads.
+
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+
+namespace othello {
+
+/// @brief Represents the type of bound for a transposition table entry
+/// @details This enum is used to indicate whether the score is an exact score,
+/// a lower bound, or an upper bound.
+enum class BoundType : uint8_t {
+  EXACT, ///< Exact score
+  LOWER, ///< Lower bound
+  UPPER  ///< Upper bound
+};
+
+/// @brief Represents a decoded transposition table entry
+/// @details score is stored from the perspective of the side to move at the
+/// position the entry belongs to.
+struct TTEntry {
+  int score;            ///< The score of the position (4 bytes)
+  uint8_t depth;        ///< The depth at which the position was evaluated (1 byte)
+  BoundType bound_type; ///< The type of bound (exact, lower, upper) (1 byte)
+  int8_t move_index;    ///< The best move found at this position (1 byte)
+  uint8_t generation;   ///< The search generation that wrote the entry (1 byte)
+}; ///< Total size: 8 bytes
+
+/// Default table size used when none is configured
+inline constexpr size_t kDefaultTTSizeMB = 64;
+
+/// @brief Lockless transposition table with 64-byte buckets
+/// @details The table is a power-of-two array of cache-line sized buckets,
+///          each holding kSlotsPerBucket entries. Every slot stores the packed
+///          entry next to (key ^ packed entry), so a probe that races with a
+///          store on another thread sees a key mismatch instead of a torn
+///          entry. One instance is meant to be shared by every worker of a
+///          search.
+class TranspositionTable {
+ public:
+  static constexpr size_t kSlotsPerBucket = 4;
+
+  /// @brief Constructor for TranspositionTable
+  /// @param size_mb The table size in megabytes, rounded down to a power of
+  ///        two number of buckets
+  explicit TranspositionTable(size_t size_mb = kDefaultTTSizeMB);
+
+  TranspositionTable(const TranspositionTable &) = delete;
+  TranspositionTable &operator=(const TranspositionTable &) = delete;
+
+  /// @brief Reallocate the table with a new size. Not thread-safe.
+  /// @param size_mb The new size in megabytes
+  void resize(size_t size_mb);
+
+  /// @brief Erase every entry. Not safe to call while a search is running.
+  void clear();
+
+  /// @brief Look up a position
+  /// @param key The Zobrist hash of the position
+  /// @param entry Filled with the stored entry on a hit
+  /// @return true if a verified entry for key was found
+  bool probe(uint64_t key, TTEntry &entry) const;
+
+  /// @brief Store a search result, replacing the least valuable slot of the
+  ///        bucket if the key is not already present
+  /// @param key The Zobrist hash of the position
+  /// @param score The score from the side to move's perspective
+  /// @param depth The remaining depth the score was searched to
+  /// @param bound_type The type of bound the score represents
+  /// @param move_index The best move found, or -1 for none
+  void store(uint64_t key, int score, uint8_t depth, BoundType bound_type,
+             int8_t move_index);
+
+  /// @brief Hint the CPU to pull the bucket for key into cache
+  /// @param key The Zobrist hash of a position that will be probed soon
+  void prefetch(uint64_t key) const {
+    __builtin_prefetch(&buckets[key & bucket_mask]);
+  }
+
+  /// @brief Start a new search generation
+  /// @details Entries are kept, but replacement treats entries from older
+  ///          generations as less valuable, so stale results age out without
+  ///          an O(size) clear.
+  void newSearch() {
+    generation.fetch_add(1, std::memory_order_relaxed);
+  }
+
+  /// @brief Return the number of buckets in the table
+  size_t bucketCount() const { return bucket_mask + 1; }
+
+  /// @brief Return the memory used by the table in bytes
+  size_t sizeBytes() const { return bucketCount() * sizeof(Bucket); }
+
+ private:
+  struct Slot {
+    std::atomic<uint64_t> check; ///< key ^ data
+    std::atomic<uint64_t> data;  ///< Packed TTEntry
+  };
+
+  struct alignas(64) Bucket {
+    Slot slots[kSlotsPerBucket];
+  };
+  static_assert(sizeof(Bucket) == 64, "buckets must fill one cache line");
+
+  std::unique_ptr<Bucket[]> buckets; ///< Bucket storage
+  size_t bucket_mask = 0;            ///< bucketCount() - 1
+
+  std::atomic<uint8_t> generation{0}; ///< Current search generation
+};
+
+} // namespace othello
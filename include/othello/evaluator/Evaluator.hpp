@@ -4,12 +4,33 @@
 
 #pragma once
 
+#include <array>
+#include <cstddef>
+#include <cstdint>
+
 #include "../GameBoard.hpp"
 
 namespace othello {
 
+/// Number of pattern codes an accumulator can hold
+inline constexpr size_t kAccumulatorCodes = 92;
+
+/// @brief Evaluation terms of one position, kept up to date move by move so
+///        a leaf does not have to rescan the board
+/// @details What the fields hold is up to the evaluator that filled them.
+///          The struct is deliberately left uninitialized on construction;
+///          only Evaluator::reset() gives it a meaning.
+struct EvalAccumulator {
+  int score;                                       ///< Sum of per-square terms
+  std::array<uint16_t, kAccumulatorCodes> codes;   ///< Pattern codes
+};
+
 /// @brief Evaluator class for Othello
 /// @details This class defines an interface for evaluating the game board.
+///          Evaluators that return true from incremental() also support
+///          carrying an EvalAccumulator along the search: reset() fills it
+///          for a root position, update() advances it by one move, and
+///          evaluate(board, accumulator) scores a position from it.
 class Evaluator {
  public:
   /// @brief Evaluates the game board
@@ -17,30 +38,102 @@ class Evaluator {
   /// @return The evaluation score of the board
   virtual int evaluate(const GameBoard &board) const = 0;
 
+  /// @brief Whether this evaluator maintains an accumulator. If not, the
+  ///        methods below do nothing and evaluate(board, accumulator) is a
+  ///        full evaluation.
+  virtual bool incremental() const { return false; }
+
+  /// @brief Fill an accumulator for a position from scratch
+  virtual void reset(const GameBoard &board,
+                     EvalAccumulator &accumulator) const {
+    (void)board;
+    (void)accumulator;
+  }
+
+  /// @brief Advance an accumulator past one move
+  /// @param accumulator The accumulator of the position before the move
+  /// @param move The square played
+  /// @param flips The discs the move flipped
+  /// @param color The color of the player making the move
+  virtual void update(EvalAccumulator &accumulator, int move, uint64_t flips,
+                      Color color) const {
+    (void)accumulator;
+    (void)move;
+    (void)flips;
+    (void)color;
+  }
+
+  /// @brief Evaluates the game board from its accumulator
+  /// @param board The game board to evaluate
+  /// @param accumulator The board's accumulator, up to date if incremental()
+  /// @return The same score as evaluate(board)
+  virtual int evaluate(const GameBoard &board,
+                       const EvalAccumulator &accumulator) const {
+    (void)accumulator;
+    return evaluate(board);
+  }
+
+  /// @brief Evaluates a position whose side to move's legal moves are known
+  /// @details Lets evaluators that score mobility skip generating them
+  ///          again; the default ignores them.
+  /// @param color The side to move
+  /// @param moves The legal moves of color
+  /// @return The same score as evaluate(board, accumulator)
+  virtual int evaluateWithMoves(const GameBoard &board,
+                                const EvalAccumulator &accumulator, Color color,
+                                uint64_t moves) const {
+    (void)color;
+    (void)moves;
+    return evaluate(board, accumulator);
+  }
+
   /// @brief Destructor for the Evaluator class
   virtual ~Evaluator() = default;
 };
 
 /// @brief PositionalEvaluator class for Othello
 /// @details This class implements an evaluation function for the game board
-///          based solely on positional factors.
+///          based solely on positional factors. Every term is a weight per
+///          square, so the accumulator holds the whole score.
 class PositionalEvaluator : public Evaluator {
  public:
   /// @brief Evaluates the game board
   /// @param board The game board to evaluate
   /// @return The evaluation score of the board
   int evaluate(const GameBoard &board) const override;
+
+  bool incremental() const override { return true; }
+  void reset(const GameBoard &board,
+             EvalAccumulator &accumulator) const override;
+  void update(EvalAccumulator &accumulator, int move, uint64_t flips,
+              Color color) const override;
+  int evaluate(const GameBoard &board,
+               const EvalAccumulator &accumulator) const override;
 };
 
 /// @brief MobilityEvaluator class for Othello
 /// @details This class implements an evaluation function for the game board
-///          based on positional factors and mobility heuristics.
+///          based on positional factors and mobility heuristics. The
+///          accumulator holds the per-square terms; mobility is computed at
+///          the leaf, reusing the side to move's moves when the search has
+///          them.
 class MobilityEvaluator : public Evaluator {
  public:
   /// @brief Evaluates the game board
   /// @param board The game board to evaluate
   /// @return The evaluation score of the board
   int evaluate(const GameBoard &board) const override;
+
+  bool incremental() const override { return true; }
+  void reset(const GameBoard &board,
+             EvalAccumulator &accumulator) const override;
+  void update(EvalAccumulator &accumulator, int move, uint64_t flips,
+              Color color) const override;
+  int evaluate(const GameBoard &board,
+               const EvalAccumulator &accumulator) const override;
+  int evaluateWithMoves(const GameBoard &board,
+                        const EvalAccumulator &accumulator, Color color,
+                        uint64_t moves) const override;
 };
 }  // namespace othello
 
@@ -0,0 +1,102 @@
+// Copyright (c) 2026 Alex Li
+// PatternEvaluator.hpp
+// Table-driven evaluator scoring edge, corner and diagonal patterns
+
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "Evaluator.hpp"
+
+namespace othello {
+
+/// @brief PatternEvaluator class for Othello
+/// @details Scores a position as the sum of learned weights, one per pattern
+///          instance. A pattern is a fixed set of squares (an edge with its
+///          two X squares, a 3x3 or 2x5 corner block, an inner line or a
+///          diagonal); each of its symmetric placements on the board reads
+///          the contents of those squares as a base-3 number (empty, side to
+///          move, opponent) and looks that number up in the pattern's table.
+///          Every game phase, bucketed by disc count, has its own tables.
+///          Scores are in the engine's units (100 per disc of final margin).
+///          Weights start at zero and are normally loaded from a file
+///          written by the trainer. The accumulator keeps every instance's
+///          code for both sides, so a move only touches the instances that
+///          cover the squares it changed.
+class PatternEvaluator : public Evaluator {
+ public:
+  /// Number of game-phase buckets
+  static constexpr int kPhases = 12;
+
+  /// Number of pattern instances scored per position
+  static constexpr size_t kInstances = 46;
+
+  /// Number of weights in the tables of one phase
+  static constexpr size_t kWeightsPerPhase = 167265;
+
+  /// Weight index of every pattern instance, relative to its phase's tables
+  using Features = std::array<uint32_t, kInstances>;
+
+  /// @brief Construct an evaluator with every weight zero
+  PatternEvaluator();
+
+  /// @brief Construct an evaluator from a weights file
+  /// @param weights_path The file to load, as written by save()
+  /// @throws std::runtime_error if the file is missing or malformed
+  explicit PatternEvaluator(const std::string &weights_path);
+
+  /// @brief Evaluates the game board
+  /// @param board The game board to evaluate
+  /// @return The evaluation score of the board from black's perspective
+  int evaluate(const GameBoard &board) const override;
+
+  bool incremental() const override { return true; }
+  void reset(const GameBoard &board,
+             EvalAccumulator &accumulator) const override;
+  void update(EvalAccumulator &accumulator, int move, uint64_t flips,
+              Color color) const override;
+  int evaluate(const GameBoard &board,
+               const EvalAccumulator &accumulator) const override;
+
+  /// @brief Evaluates a position from the side to move's perspective
+  /// @param player The discs of the side to move
+  /// @param opponent The discs of the other side
+  int evaluate(uint64_t player, uint64_t opponent) const;
+
+  /// @brief The phase bucket of a position
+  static int phase(uint64_t player, uint64_t opponent);
+
+  /// @brief Compute the table index of every pattern instance
+  /// @param player The discs of the side to move
+  /// @param opponent The discs of the other side
+  /// @param features Receives one index per instance
+  static void features(uint64_t player, uint64_t opponent, Features &features);
+
+  /// @brief The weights of one phase, kWeightsPerPhase entries
+  int16_t *phaseWeights(int phase) {
+    return weights.data() + static_cast<size_t>(phase) * kWeightsPerPhase;
+  }
+  const int16_t *phaseWeights(int phase) const {
+    return weights.data() + static_cast<size_t>(phase) * kWeightsPerPhase;
+  }
+
+  /// @brief Replace the weights with those stored in a file
+  /// @throws std::runtime_error if the file is missing or malformed, in
+  ///         which case the current weights are kept
+  void load(const std::string &path);
+
+  /// @brief Write the weights to a file
+  /// @throws std::runtime_error if the file cannot be written
+  void save(const std::string &path) const;
+
+ private:
+  std::vector<int16_t> weights;
+};
+
+static_assert(2 * PatternEvaluator::kInstances <= kAccumulatorCodes);
+
+} // namespace othello
@@ -0,0 +1,65 @@
+// Copyright (c) 2026 Alex Li
+// SquareWeights.hpp
+// Per-square weight tables shared by the region-based evaluators
+
+#pragma once
+
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "../Constants.hpp"
+#include "../GameBoard.hpp"
+
+namespace othello {
+
+using SquareWeights = std::array<int, 64>;
+
+/// @brief Build a table giving every square the weight of its region
+/// @param disc Weight every disc gets on top of its region's weight
+constexpr SquareWeights makeSquareWeights(int corner, int x_square,
+                                          int c_square, int a_square,
+                                          int b_square, int middle, int disc) {
+  SquareWeights weights{};
+  for (int square = 0; square < 64; ++square) {
+    const uint64_t bit = 1ULL << square;
+    weights[square] = disc;
+    if (bit & CORNER_MASK) {
+      weights[square] += corner;
+    } else if (bit & X_SQUARE_MASK) {
+      weights[square] += x_square;
+    } else if (bit & C_SQUARE_MASK) {
+      weights[square] += c_square;
+    } else if (bit & A_SQUARE_MASK) {
+      weights[square] += a_square;
+    } else if (bit & B_SQUARE_MASK) {
+      weights[square] += b_square;
+    } else if (bit & MID_SQUARE_MASK) {
+      weights[square] += middle;
+    }
+  }
+  return weights;
+}
+
+/// @brief Black's weighted disc total minus white's
+inline int squareScore(const SquareWeights &weights, const GameBoard &board) {
+  int score = 0;
+  for (int square = 0; square < 64; ++square) {
+    score += weights[square] * (static_cast<int>((board.black_bb >> square) & 1) -
+                                static_cast<int>((board.white_bb >> square) & 1));
+  }
+  return score;
+}
+
+/// @brief Change in squareScore() when color plays move and flips flips:
+///        the new disc counts once, each flipped disc twice
+inline int squareScoreDelta(const SquareWeights &weights, int move,
+                            uint64_t flips, Color color) {
+  int delta = weights[move];
+  for (; flips; flips &= flips - 1) {
+    delta += 2 * weights[std::countr_zero(flips)];
+  }
+  return static_cast<int>(color) * delta;
+}
+
+} // namespace othello
@@ -1,21 +1,114 @@
 // Copyright (c) 2026 Alex Li
 // ThreadPool.hpp
-// Thread pool class to manage a pool of threads for parallel execution.
+// Work-stealing thread pool to manage a pool of threads for parallel
+// execution.
 
 #pragma once
 
+#include <atomic>
+#include <chrono>
 #include <condition_variable>
-#include <functional>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <exception>
 #include <future>
+#include <memory>
 #include <mutex>
-#include <queue>
+#include <new>
+#include <stdexcept>
 #include <thread>
 #include <tuple>
 #include <type_traits>
+#include <utility>
 #include <vector>
 
 namespace utils {
 
+class ThreadPool;
+
+/// @brief Counts the outstanding tasks spawned into it
+/// @details A group must outlive every task spawned into it; ThreadPool::wait
+///          returns once all of them have finished, and rethrows the first
+///          exception any of them threw.
+class TaskGroup {
+public:
+  TaskGroup() = default;
+  TaskGroup(const TaskGroup &) = delete;
+  TaskGroup &operator=(const TaskGroup &) = delete;
+
+  /// @brief Return true once every spawned task has finished
+  bool done() const { return pending.load(std::memory_order_acquire) == 0; }
+
+private:
+  friend class ThreadPool;
+  std::atomic<int> pending{0};
+  std::atomic<int> parked{0}; ///< Threads asleep in wait() on this group
+  std::mutex mutex;           ///< Guards error and parking
+  std::condition_variable finished;
+  std::exception_ptr error; ///< First exception a task threw, until wait()
+};
+
+/// @brief Type-erased callable with inline storage
+/// @details Callables up to kInlineSize bytes are stored inside the task, so
+///          spawning one does not allocate; larger callables fall back to the
+///          heap. Tasks are referenced by address while queued, so they are
+///          neither copyable nor movable: keep them in caller-owned storage
+///          (e.g. a std::array on the stack) until the group is waited on.
+class Task {
+public:
+  static constexpr size_t kInlineSize = 96;
+
+  Task() = default;
+  template <typename F>
+    requires(!std::is_same_v<std::decay_t<F>, Task>)
+  explicit Task(F &&f) {
+    emplace(std::forward<F>(f));
+  }
+  ~Task() { reset(); }
+
+  Task(const Task &) = delete;
+  Task &operator=(const Task &) = delete;
+
+  /// @brief Replace the stored callable
+  template <typename F> void emplace(F &&f) {
+    using Fn_t = std::decay_t<F>;
+    reset();
+    if constexpr (sizeof(Fn_t) <= kInlineSize &&
+                  alignof(Fn_t) <= alignof(std::max_align_t) &&
+                  std::is_nothrow_move_constructible_v<Fn_t>) {
+      ::new (static_cast<void *>(storage)) Fn_t(std::forward<F>(f));
+      invoke_fn = [](void *p) { (*static_cast<Fn_t *>(p))(); };
+      destroy_fn = [](void *p) { static_cast<Fn_t *>(p)->~Fn_t(); };
+    } else {
+      ::new (static_cast<void *>(storage)) Fn_t *(new Fn_t(std::forward<F>(f)));
+      invoke_fn = [](void *p) { (**static_cast<Fn_t **>(p))(); };
+      destroy_fn = [](void *p) { delete *static_cast<Fn_t **>(p); };
+    }
+  }
+
+  /// @brief Destroy the stored callable, if any
+  void reset() {
+    if (destroy_fn != nullptr) {
+      destroy_fn(storage);
+      invoke_fn = nullptr;
+      destroy_fn = nullptr;
+    }
+  }
+
+  /// @brief Run the stored callable
+  void operator()() { invoke_fn(storage); }
+
+private:
+  friend class ThreadPool;
+
+  alignas(std::max_align_t) std::byte storage[kInlineSize];
+  void (*invoke_fn)(void *) = nullptr;
+  void (*destroy_fn)(void *) = nullptr;
+  TaskGroup *group = nullptr; ///< Group to notify on completion
+  bool heap_owned = false;    ///< Deleted by the pool after running
+};
+
 class ThreadPool {
 
 public:
@@ -25,7 +118,32 @@ public:
   ThreadPool(const ThreadPool &) = delete;
   ThreadPool &operator=(const ThreadPool &) = delete;
 
+  ///@brief Queue a caller-owned task as part of a group.
+  ///@details Tasks spawned from a worker go to that worker's own deque,
+  ///         where idle workers can steal them, without allocating; if that
+  ///         deque already holds WorkQueue::kCapacity tasks, the task runs
+  ///         inline instead, before spawn returns. Tasks spawned from other
+  ///         threads go to a shared injection queue, which may allocate. The
+  ///         task must stay alive until wait(group) returns.
+  ///@param group Group that tracks completion of the task.
+  ///@param task Task to run.
+  void spawn(TaskGroup &group, Task &task);
+
+  ///@brief Block until every task in the group has finished.
+  ///@details The waiting thread keeps executing queued tasks (its own first,
+  ///         then stolen ones) instead of sleeping, so workers may wait on
+  ///         tasks they spawned without deadlocking the pool. A thread
+  ///         outside the pool that finds no task to run for a while sleeps
+  ///         until the group finishes instead, waking every kParkInterval to
+  ///         look for tasks again. A task that
+  ///         throws still counts as finished; the first such exception is
+  ///         rethrown here once the whole group has finished.
+  ///@param group Group to wait on.
+  void wait(TaskGroup &group);
+
   ///@brief Enqueue a task to be executed by the thread pool.
+  ///@details Convenience wrapper over the task API for fire-and-forget work;
+  ///         it allocates the task and a future's shared state.
   ///@param f Function to be executed.
   ///@param args Arguments to be passed to the function.
   ///@return A future that will hold the result of the function execution.
@@ -36,32 +154,86 @@ public:
     using Fn_t = std::decay_t<F>;
     using ArgsTuple_t = std::tuple<std::decay_t<Args>...>;
 
-    auto task = std::make_shared<std::packaged_task<ReturnType()>>(
+    std::promise<ReturnType> promise;
+    std::future<ReturnType> res = promise.get_future();
+    auto task = std::make_unique<Task>(
         [f = Fn_t(std::forward<F>(f)),
-         argsTuple =
-             ArgsTuple_t(std::forward<Args>(args)...)]() mutable -> ReturnType {
-          // Unpack the tuple and call the function
-          return std::apply(std::move(f), std::move(argsTuple));
+         argsTuple = ArgsTuple_t(std::forward<Args>(args)...),
+         promise = std::move(promise)]() mutable {
+          try {
+            if constexpr (std::is_void_v<ReturnType>) {
+              std::apply(std::move(f), std::move(argsTuple));
+              promise.set_value();
+            } else {
+              promise.set_value(std::apply(std::move(f), std::move(argsTuple)));
+            }
+          } catch (...) {
+            promise.set_exception(std::current_exception());
+          }
         });
-    std::future<ReturnType> res = task->get_future();
-    {
-      std::unique_lock<std::mutex> lock(queueMutex);
-      if (stop) {
-        // Don't allow enqueueing after stopping the pool
-        throw std::runtime_error("Enqueue on stopped ThreadPool");
-      }
-      tasks.emplace([task]() { (*task)(); });
-    }
-    condition.notify_one(); // Notify one worker thread that a task is available
+    task->heap_owned = true;
+    submit(task.release());
     // Return the future to the caller
     return res;
   }
 
+  /// How long a thread outside the pool sleeps in wait() between looks for
+  /// tasks to run
+  static constexpr std::chrono::milliseconds kParkInterval{1};
+
+  ///@brief Return the number of worker threads.
+  size_t size() const { return workers.size(); }
+
+  ///@brief Return the index of the calling worker thread in this pool, or
+  ///       -1 if the caller is not one of this pool's workers.
+  int workerIndex() const;
+
+  ///@brief Return whether the calling thread is inside wait(), so that any
+  ///       task it is running was picked up while helping, possibly from
+  ///       another group.
+  ///@details Long-running tasks can check this and return early rather than
+  ///         hold up the wait that picked them up.
+  static bool insideWait();
+
 private:
-  std::vector<std::thread> workers;        // Vector of worker threads
-  std::queue<std::function<void()>> tasks; // Queue of tasks to be executed
-  std::mutex queueMutex; // Mutex to protect access to the task queue
-  std::condition_variable condition; // Condition variable for task notification
-  bool stop;                         // Flag to indicate if the pool is stopping
+  /// @brief Chase-Lev work-stealing deque of task pointers
+  /// @details The owning worker pushes and pops at the bottom; any thread may
+  ///          steal from the top. Capacity is fixed; push fails when full.
+  class WorkQueue {
+  public:
+    static constexpr int64_t kCapacity = 1024;
+
+    bool push(Task *task);
+    Task *pop();
+    Task *steal();
+    bool empty() const;
+
+  private:
+    alignas(64) std::atomic<int64_t> top{0};
+    alignas(64) std::atomic<int64_t> bottom{0};
+    std::atomic<Task *> buffer[kCapacity] = {};
+  };
+
+  void workerLoop(size_t index);
+  void submit(Task *task);
+  void execute(Task *task);
+  Task *findTask(int index);
+  bool hasWork() const;
+  void notifyWorker();
+
+  std::vector<std::thread> workers;               // Vector of worker threads
+  std::vector<std::unique_ptr<WorkQueue>> queues; // One deque per worker
+
+  // Tasks submitted from threads outside the pool
+  std::mutex injectMutex;
+  std::deque<Task *> injected;
+  std::atomic<size_t> injectedCount{0};
+
+  // Idle workers sleep here until new work arrives
+  std::mutex sleepMutex;
+  std::condition_variable sleepCondition;
+  std::atomic<int> sleepers{0};
+  uint64_t wakeEpoch = 0; // Guarded by sleepMutex
+  std::atomic<bool> stop{false}; // Flag to indicate if the pool is stopping
 };
 } // namespace utils
@@ -0,0 +1,202 @@
+// Copyright (c) 2026 Alex Li
+// BatchSearcher.cpp
+// Implementation of batch position search
+
+#include "othello/BatchSearcher.hpp"
+
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+
+namespace othello {
+
+BatchSearcher::BatchSearcher(const Evaluator &evaluator,
+                             utils::ThreadPool &thread_pool,
+                             const BatchOptions &options)
+    : BatchSearcher(evaluator, thread_pool, options,
+                    std::make_unique<TranspositionTable>(options.tt_size_mb),
+                    std::make_unique<EndgameSolver>(), nullptr, nullptr) {}
+
+BatchSearcher::BatchSearcher(const Evaluator &evaluator,
+                             utils::ThreadPool &thread_pool,
+                             const BatchOptions &options,
+                             TranspositionTable &shared_table,
+                             EndgameSolver &shared_solver)
+    : BatchSearcher(evaluator, thread_pool, options, nullptr, nullptr,
+                    &shared_table, &shared_solver) {}
+
+BatchSearcher::BatchSearcher(const Evaluator &evaluator,
+                             utils::ThreadPool &thread_pool,
+                             const BatchOptions &options,
+                             std::unique_ptr<TranspositionTable> own_table,
+                             std::unique_ptr<EndgameSolver> own_solver,
+                             TranspositionTable *shared_table,
+                             EndgameSolver *shared_solver)
+    : thread_pool(thread_pool), evaluator(evaluator), options(options),
+      owned_table(std::move(own_table)),
+      table(shared_table != nullptr ? *shared_table : *owned_table),
+      owned_solver(std::move(own_solver)),
+      solver(shared_solver != nullptr ? *shared_solver : *owned_solver),
+      stop_condition([this] { return stopped(); }),
+      tasks(options.max_parallel > 0
+                ? options.max_parallel
+                : std::max<size_t>(1, thread_pool.size())) {
+  free_tasks.reserve(tasks.size());
+  for (utils::Task &task : tasks) {
+    task.emplace([this, &task]() { drain(task); });
+    free_tasks.push_back(&task);
+  }
+}
+
+BatchSearcher::~BatchSearcher() {
+  cancel();
+  // Queued positions are still taken, but only to find the batch cancelled
+  thread_pool.wait(group);
+}
+
+size_t BatchSearcher::submit(const GameBoard &board, Color color,
+                             uint8_t max_depth, int time_limit_ms) {
+  utils::Task *task = nullptr;
+  size_t index;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (submitted == 0) {
+      started = std::chrono::steady_clock::now();
+    }
+    index = submitted++;
+    queue.push_back({index, board, color, max_depth, time_limit_ms});
+    // Otherwise every slot is draining and one of them takes it
+    if (!free_tasks.empty()) {
+      task = free_tasks.back();
+      free_tasks.pop_back();
+    }
+  }
+  if (task != nullptr) {
+    thread_pool.spawn(group, *task);
+  }
+  return index;
+}
+
+void BatchSearcher::close() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    closed = true;
+  }
+  result_ready.notify_all();
+}
+
+void BatchSearcher::cancel() {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    cancelled.store(true, std::memory_order_relaxed);
+    results.clear();
+  }
+  result_ready.notify_all();
+}
+
+std::optional<BatchResult> BatchSearcher::next() {
+  std::unique_lock<std::mutex> lock(mutex);
+  result_ready.wait(lock, [this] {
+    return !results.empty() || cancelled.load(std::memory_order_relaxed) ||
+           (closed && finished == submitted);
+  });
+  if (results.empty() || cancelled.load(std::memory_order_relaxed)) {
+    return std::nullopt;
+  }
+  BatchResult result = std::move(results.front());
+  results.pop_front();
+  return result;
+}
+
+size_t BatchSearcher::completed() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return searched;
+}
+
+double BatchSearcher::positionsPerSecond() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (submitted == 0) {
+    return 0;
+  }
+  const double seconds = std::chrono::duration<double>(
+                             std::chrono::steady_clock::now() - started)
+                             .count();
+  return seconds > 0 ? searched / seconds : 0;
+}
+
+void BatchSearcher::drain(utils::Task &slot) {
+  // A thread that picked the slot up while waiting on its own tasks takes
+  // one position only, so it is back to its own wait after one search
+  const bool helping = utils::ThreadPool::insideWait();
+  std::unique_lock<std::mutex> lock(mutex);
+  while (!queue.empty()) {
+    const Job job = std::move(queue.front());
+    queue.pop_front();
+    lock.unlock();
+    search(job);
+    lock.lock();
+    if (helping && !queue.empty()) {
+      lock.unlock();
+      thread_pool.spawn(group, slot);
+      return;
+    }
+  }
+  free_tasks.push_back(&slot);
+}
+
+void BatchSearcher::search(const Job &job) {
+  std::optional<BatchResult> result;
+  if (!stopped()) {
+    // The batch's deadline caps every position's own limit
+    const int64_t remaining_ms =
+        std::chrono::duration_cast<std::chrono::milliseconds>(
+            options.deadline - std::chrono::steady_clock::now())
+            .count();
+    const int time_limit_ms = static_cast<int>(std::clamp<int64_t>(
+        remaining_ms, 0, std::max(job.time_limit_ms, 0)));
+    Engine *engine = acquireEngine();
+    const int best_move = engine->findBestMove(
+        job.board, job.max_depth, job.color, time_limit_ms, stop_condition);
+    result = BatchResult{job.index, job.board, job.color, best_move,
+                         engine->lastSearchStats()};
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.push_back(engine);
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    ++finished;
+    // A search cut short by cancel() answers nobody
+    if (result && !cancelled.load(std::memory_order_relaxed)) {
+      ++searched;
+      results.push_back(std::move(*result));
+    }
+  }
+  result_ready.notify_all();
+}
+
+bool BatchSearcher::stopped() const {
+  return cancelled.load(std::memory_order_relaxed) ||
+         std::chrono::steady_clock::now() >= options.deadline ||
+         (options.stop_condition && options.stop_condition());
+}
+
+Engine *BatchSearcher::acquireEngine() {
+  std::lock_guard<std::mutex> lock(mutex);
+  if (!idle.empty()) {
+    Engine *engine = idle.back();
+    idle.pop_back();
+    return engine;
+  }
+  engines.push_back(
+      std::make_unique<Engine>(evaluator, thread_pool, table, solver));
+  Engine &engine = *engines.back();
+  engine.setVerbose(false);
+  engine.setSearchMode(SearchMode::SERIAL);
+  engine.setSearchDriver(options.search_driver);
+  engine.setEndgameEmpties(options.endgame_empties);
+  engine.setOpeningBook(options.opening_book);
+  return &engine;
+}
+
+} // namespace othello
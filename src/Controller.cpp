@@ -5,6 +5,10 @@
 
 #include "othello/Controller.hpp"
 
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <chrono>
 #include <iostream>
 #include <limits>  // For std::numeric_limits
 #include <set>
@@ -18,8 +22,22 @@
 namespace othello {
 
 void Controller::startGame(int depth, int time_limit_ms) {
+  play(depth, time_limit_ms, std::nullopt);
+}
+
+void Controller::startGame(int depth, const GameClock &clock) {
+  play(depth, 0, clock);
+}
+
+void Controller::play(int depth, int time_limit_ms,
+                      std::optional<GameClock> clock) {
+  std::array<GameClock, 2> clocks{};  // Black's, then white's
+  if (clock) {
+    clocks.fill(*clock);
+  }
   Color current_color = Color::BLACK;  // Start with black player
   int moves = 0;
+  engine.newGame();
   while (true) {
     ++moves;
     if (isTerminal(board)) {
@@ -36,7 +54,24 @@ void Controller::startGame(int depth, int time_limit_ms) {
     }
     std::cout << std::endl;
     utils::profiler::enable();
-    int ai_move = engine.findBestMove(board, depth, current_color, time_limit_ms);
+    int ai_move;
+    if (clock) {
+      GameClock &own = clocks[current_color == Color::BLACK ? 0 : 1];
+      const int empties = 64 - std::popcount(board.black_bb | board.white_bb);
+      TimeManager time(TimeManager::allocate(own, empties));
+      const auto start = std::chrono::steady_clock::now();
+      ai_move = engine.findBestMove(board, depth, current_color, time);
+      const auto used = std::chrono::duration_cast<std::chrono::milliseconds>(
+          std::chrono::steady_clock::now() - start);
+      own.remaining_ms = std::max(
+          0, own.remaining_ms - static_cast<int>(used.count())) +
+          own.increment_ms;
+      std::cout << "Used " << used.count() << " ms of a "
+                << time.budget().soft_ms << " ms budget, "
+                << own.remaining_ms << " ms left" << std::endl;
+    } else {
+      ai_move = engine.findBestMove(board, depth, current_color, time_limit_ms);
+    }
     utils::profiler::disable();
     if (ai_move == -1) {
       std::cout << "No valid moves available for AI. Passing." << std::endl;
@@ -0,0 +1,328 @@
+// Copyright (c) 2026 Alex Li
+// EndgameSolver.cpp
+// Implementation of the exact endgame solver
+
+#include "othello/EndgameSolver.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+
+#include "othello/Hash.hpp"
+#include "othello/OthelloRules.hpp"
+
+namespace othello {
+
+namespace {
+
+/// At or below this many empties the solver stops using the table
+constexpr int kShallowEmpties = 7;
+
+/// At or below this many empties the dedicated kernels take over
+constexpr int kLastEmpties = 4;
+
+/// Squares of each 4x4 quadrant of the board
+constexpr std::array<uint64_t, 4> kQuadrants = {
+    0x000000000F0F0F0FULL, 0x00000000F0F0F0F0ULL, 0x0F0F0F0F00000000ULL,
+    0xF0F0F0F000000000ULL};
+
+/// @brief Return a mask of the quadrants holding an odd number of empties
+/// @details Moving into such a region first tends to leave the last move of
+///          the region to us, which is the classic parity heuristic.
+uint64_t oddQuadrants(uint64_t empty) {
+  uint64_t odd = 0;
+  for (uint64_t quadrant : kQuadrants) {
+    if (std::popcount(empty & quadrant) & 1) {
+      odd |= quadrant;
+    }
+  }
+  return odd;
+}
+
+/// @brief Score of a finished game, empties going to the winner
+int finalScore(uint64_t player, uint64_t opponent) {
+  const int p = std::popcount(player);
+  const int o = std::popcount(opponent);
+  const int empties = 64 - p - o;
+  if (p > o) {
+    return p - o + empties;
+  }
+  if (p < o) {
+    return p - o - empties;
+  }
+  return 0;
+}
+
+/// @brief Mix both bitboards into a key for the solver's table
+/// @details The solver works on (player, opponent) pairs rather than boards
+///          with a colour, so the engine's Zobrist keys do not apply.
+uint64_t hashPosition(uint64_t player, uint64_t opponent) {
+  return mixBitboards(player, opponent);
+}
+
+/// @brief Solve the last empty square
+int solveLast1(uint64_t player, uint64_t opponent, int square,
+               uint64_t &nodes) {
+  ++nodes;
+  // Disc differential if the player fills the square without flipping
+  const int score = 2 * std::popcount(player) - 62;
+  const uint64_t flips = getFlips(player, opponent, square);
+  if (flips) {
+    return score + 2 * std::popcount(flips);
+  }
+  const uint64_t op_flips = getFlips(opponent, player, square);
+  if (op_flips) {
+    return score - 2 - 2 * std::popcount(op_flips);
+  }
+  // Nobody can move: the empty square goes to the winner
+  return score > 0 ? score : score - 2;
+}
+
+/// @brief Solve the last N empties, given in parity order
+template <size_t N>
+int solveLast(uint64_t player, uint64_t opponent, int alpha, int beta,
+              const std::array<int, N> &squares, bool passed,
+              uint64_t &nodes) {
+  if constexpr (N == 1) {
+    return solveLast1(player, opponent, squares[0], nodes);
+  } else {
+    ++nodes;
+    int best = -kMaxEndgameScore - 1;
+    for (size_t i = 0; i < N; ++i) {
+      const uint64_t flips = getFlips(player, opponent, squares[i]);
+      if (!flips) {
+        continue;
+      }
+      std::array<int, N - 1> rest;
+      for (size_t j = 0, k = 0; j < N; ++j) {
+        if (j != i) {
+          rest[k++] = squares[j];
+        }
+      }
+      const int score =
+          -solveLast<N - 1>(opponent ^ flips,
+                            player | flips | (1ULL << squares[i]), -beta,
+                            -alpha, rest, false, nodes);
+      if (score > best) {
+        best = score;
+        if (score > alpha) {
+          alpha = score;
+          if (alpha >= beta) {
+            break;
+          }
+        }
+      }
+    }
+    if (best > -kMaxEndgameScore - 1) {
+      return best;
+    }
+    if (passed) {
+      return finalScore(player, opponent);
+    }
+    return -solveLast<N>(opponent, player, -beta, -alpha, squares, true,
+                         nodes);
+  }
+}
+
+/// @brief Collect the last kLastEmpties or fewer squares, odd quadrants
+///        first, and dispatch to the matching kernel
+int searchLast(uint64_t player, uint64_t opponent, int alpha, int beta,
+               uint64_t &nodes) {
+  const uint64_t empty = ~(player | opponent);
+  const uint64_t odd = oddQuadrants(empty);
+  std::array<int, kLastEmpties> squares{};
+  size_t count = 0;
+  for (uint64_t set : {empty & odd, empty & ~odd}) {
+    for (; set; set &= set - 1) {
+      squares[count++] = std::countr_zero(set);
+    }
+  }
+  switch (count) {
+  case 0:
+    return finalScore(player, opponent);
+  case 1:
+    return solveLast1(player, opponent, squares[0], nodes);
+  case 2:
+    return solveLast<2>(player, opponent, alpha, beta, {squares[0], squares[1]},
+                        false, nodes);
+  case 3:
+    return solveLast<3>(player, opponent, alpha, beta,
+                        {squares[0], squares[1], squares[2]}, false, nodes);
+  default:
+    return solveLast<4>(player, opponent, alpha, beta, squares, false, nodes);
+  }
+}
+
+/// @brief Parity-ordered alpha-beta without the table
+/// @param moves The player's legal moves
+int searchShallow(uint64_t player, uint64_t opponent, uint64_t moves,
+                  int alpha, int beta, uint64_t &nodes) {
+  ++nodes;
+  const uint64_t empty = ~(player | opponent);
+  if (!moves) {
+    const uint64_t opponent_moves = getMoves(opponent, player);
+    if (!opponent_moves) {
+      return finalScore(player, opponent);
+    }
+    return -searchShallow(opponent, player, opponent_moves, -beta, -alpha,
+                          nodes);
+  }
+  const bool last = std::popcount(empty) - 1 <= kLastEmpties;
+  const uint64_t odd = oddQuadrants(empty);
+  int best = -kMaxEndgameScore - 1;
+  for (uint64_t set : {moves & odd, moves & ~odd}) {
+    for (; set; set &= set - 1) {
+      const int square = std::countr_zero(set);
+      const uint64_t flips = getFlips(player, opponent, square);
+      const uint64_t next_player = opponent ^ flips;
+      const uint64_t next_opponent = player | flips | (1ULL << square);
+      const int score =
+          last ? -searchLast(next_player, next_opponent, -beta, -alpha, nodes)
+               : -searchShallow(next_player, next_opponent,
+                                getMoves(next_player, next_opponent), -beta,
+                                -alpha, nodes);
+      if (score > best) {
+        best = score;
+        if (score > alpha) {
+          alpha = score;
+          if (alpha >= beta) {
+            return best;
+          }
+        }
+      }
+    }
+  }
+  return best;
+}
+
+} // namespace
+
+EndgameSolver::EndgameSolver(size_t tt_size_mb) : tt(tt_size_mb) {}
+
+int EndgameSolver::solve(uint64_t player, uint64_t opponent, int alpha,
+                         int beta, uint64_t &nodes, const SolveAbort &abort) {
+  const int empties = 64 - std::popcount(player | opponent);
+  if (empties <= kLastEmpties) {
+    return searchLast(player, opponent, alpha, beta, nodes);
+  }
+  const uint64_t moves = getMoves(player, opponent);
+  if (empties <= kShallowEmpties) {
+    return searchShallow(player, opponent, moves, alpha, beta, nodes);
+  }
+  AbortPoll poll{abort, nodes + kAbortPollNodes};
+  return searchDeep(player, opponent, moves, alpha, beta, nodes, poll);
+}
+
+int EndgameSolver::searchDeep(uint64_t player, uint64_t opponent,
+                              uint64_t moves, int alpha, int beta,
+                              uint64_t &nodes, AbortPoll &poll) {
+  ++nodes;
+  if (poll.abort && nodes >= poll.next_poll) {
+    poll.next_poll = nodes + kAbortPollNodes;
+    poll.aborted = poll.aborted || poll.abort();
+  }
+  if (poll.aborted) {
+    return 0;
+  }
+  const uint64_t key = hashPosition(player, opponent);
+  const int empties = 64 - std::popcount(player | opponent);
+  int tt_move = -1;
+  TTEntry entry;
+  if (tt.probe(key, entry)) {
+    if (entry.bound_type == BoundType::EXACT ||
+        (entry.bound_type == BoundType::LOWER && entry.score >= beta) ||
+        (entry.bound_type == BoundType::UPPER && entry.score <= alpha)) {
+      return entry.score;
+    }
+    tt_move = entry.move_index;
+  }
+
+  if (!moves) {
+    const uint64_t opponent_moves = getMoves(opponent, player);
+    if (!opponent_moves) {
+      return finalScore(player, opponent);
+    }
+    return -searchDeep(opponent, player, opponent_moves, -beta, -alpha, nodes,
+                       poll);
+  }
+
+  // Fastest-first: try the moves that leave the opponent the fewest replies.
+  // The stored best move, if any, goes first.
+  struct Candidate {
+    int square;
+    int sort_key;
+    uint64_t flips;
+    uint64_t replies; ///< Passed on so the child doesn't generate them again
+  };
+  std::array<Candidate, 64> candidates;
+  size_t count = 0;
+  for (; moves; moves &= moves - 1) {
+    const int square = std::countr_zero(moves);
+    const uint64_t flips = getFlips(player, opponent, square);
+    const uint64_t replies =
+        getMoves(opponent ^ flips, player | flips | (1ULL << square));
+    candidates[count++] = {
+        square, square == tt_move ? -1 : std::popcount(replies), flips,
+        replies};
+  }
+  std::sort(candidates.begin(), candidates.begin() + count,
+            [](const Candidate &a, const Candidate &b) {
+              return a.sort_key < b.sort_key;
+            });
+
+  const int alpha_orig = alpha;
+  const bool shallow_children = empties - 1 <= kShallowEmpties;
+  auto search_child = [&](const Candidate &move, int child_alpha,
+                          int child_beta) {
+    const uint64_t next_player = opponent ^ move.flips;
+    const uint64_t next_opponent = player | move.flips | (1ULL << move.square);
+    return shallow_children
+               ? -searchShallow(next_player, next_opponent, move.replies,
+                                -child_beta, -child_alpha, nodes)
+               : -searchDeep(next_player, next_opponent, move.replies,
+                             -child_beta, -child_alpha, nodes, poll);
+  };
+
+  int best = -kMaxEndgameScore - 1;
+  int best_move = -1;
+  for (size_t i = 0; i < count; ++i) {
+    int score;
+    if (i == 0) {
+      score = search_child(candidates[i], alpha, beta);
+    } else {
+      // PVS: prove the move is no better with a null window first
+      score = search_child(candidates[i], alpha, alpha + 1);
+      if (score > alpha && score < beta) {
+        score = search_child(candidates[i], alpha, beta);
+      }
+    }
+    if (poll.aborted) {
+      return 0; // Incomplete; never store it
+    }
+    if (score > best) {
+      best = score;
+      best_move = candidates[i].square;
+      if (score > alpha) {
+        alpha = score;
+        if (alpha >= beta) {
+          break;
+        }
+      }
+    }
+  }
+
+  BoundType bound_type;
+  if (best <= alpha_orig) {
+    bound_type = BoundType::UPPER;
+  } else if (best >= beta) {
+    bound_type = BoundType::LOWER;
+  } else {
+    bound_type = BoundType::EXACT;
+  }
+  tt.store(key, best, static_cast<uint8_t>(empties), bound_type,
+           static_cast<int8_t>(best_move));
+  return best;
+}
+
+} // namespace othello
@@ -5,85 +5,283 @@
 #include "othello/Engine.hpp"
 
 #include <algorithm>
+#include <array>
 #include <atomic>
 #include <bit>
 #include <chrono> // For timing
 #include <cstdint>
+#include <functional>
 #include <iostream>
-#include <unordered_map>
+#include <mutex>
+#include <thread>
 
 #include "othello/Constants.hpp"
 #include "othello/GameBoard.hpp"
+#include "othello/Hash.hpp"
 #include "othello/OthelloRules.hpp"
+#include "othello/Symmetry.hpp"
 
 static constexpr int INF = 1 << 20;
 
 namespace othello {
 
-using TT = std::unordered_map<uint64_t, TTEntry>;
-
 namespace {
-std::vector<int> order_moves(uint64_t moves_bb,
-                 const TT &tt,
-                 uint64_t zobrist_hash) {
-  // prefer corners and edges
-  // 1. corners
-  uint64_t corner_board = moves_bb & CORNER_MASK;
-  moves_bb &= ~CORNER_MASK;
-  // 2. edges
-  uint64_t edge_board = moves_bb & (EDGE_MASK);
-  moves_bb &= ~(EDGE_MASK);
-  std::vector<int> moves;
-  auto append_positions = [&moves](uint64_t bb) {
-    while (bb) {
-      int pos = std::countr_zero(bb);
-      moves.push_back(pos);
-      bb &= bb - 1;
-    }
-  };
-  append_positions(corner_board);
-  append_positions(edge_board);
-  append_positions(moves_bb);
 
-  auto it = tt.find(zobrist_hash);
-  if (it != tt.end()) {
-    int tt_move = it->second.move_index;
-    auto pos = std::find(moves.begin(), moves.end(), tt_move);
-    if (pos != moves.end()) {
-      std::iter_swap(moves.begin(), pos);
+// Move ordering scores: the hash move first, then corners, then the two
+// killer moves, then the moves that leave the opponent the fewest replies,
+// with history scores as a bonus.
+constexpr int kHashMoveScore = 1 << 30;
+constexpr int kCornerScore = 1 << 20;
+constexpr std::array<int, 2> kKillerScores = {1 << 19, 1 << 18};
+constexpr int kReplyPenalty = 1 << 8;
+
+/// History scores are halved once any of them exceeds this
+constexpr int32_t kHistoryMax = 1 << 16;
+
+/// History scores are divided by this when added to a move's score
+constexpr int kHistoryShift = 4;
+
+/// Remaining depth from which mobility is worth computing for ordering
+constexpr uint8_t kMobilityOrderingDepth = 2;
+
+/// @brief Fill moves with the legal moves in moves_bb and their ordering
+///        scores
+/// @param hash_move The best move stored in the transposition table, or -1
+/// @param use_mobility Whether to score by the opponent's replies
+/// @param killers The killer moves at this ply, or nullptr
+/// @param history The history scores of color, or nullptr
+void scoreMoves(const GameBoard &board, uint64_t moves_bb, Color color,
+                int hash_move, bool use_mobility,
+                const std::array<int8_t, 2> *killers,
+                const std::array<int32_t, 64> *history, MoveList &moves) {
+  const uint64_t my_board =
+      color == Color::BLACK ? board.black_bb : board.white_bb;
+  const uint64_t op_board =
+      color == Color::BLACK ? board.white_bb : board.black_bb;
+  for (; moves_bb; moves_bb &= moves_bb - 1) {
+    const int square = std::countr_zero(moves_bb);
+    const uint64_t square_bb = 1ULL << square;
+    int score = 0;
+    if (square == hash_move) {
+      score = kHashMoveScore;
+    } else {
+      if (square_bb & CORNER_MASK) {
+        score += kCornerScore;
+      }
+      if (killers != nullptr) {
+        if (square == (*killers)[0]) {
+          score += kKillerScores[0];
+        } else if (square == (*killers)[1]) {
+          score += kKillerScores[1];
+        }
+      }
+      if (history != nullptr) {
+        score += (*history)[square] >> kHistoryShift;
+      }
     }
+    if (use_mobility) {
+      // Every move is played, the hash move too, so the search can reuse
+      // the flips and replies once it gets to the move
+      const uint64_t flips = getFlips(my_board, op_board, square);
+      const uint64_t replies =
+          getMoves(op_board ^ flips, my_board | flips | square_bb);
+      if (square != hash_move) {
+        score -= kReplyPenalty * std::popcount(replies);
+      }
+      moves.push(square, score, flips, replies);
+    } else {
+      moves.push(square, score);
+    }
+  }
+}
+
+/// @brief The position after color plays move, with the opponent to move
+///        even if it has to pass
+/// @param flips Receives the discs the move flipped
+GameBoard playMove(const GameBoard &board, int move, Color color,
+                   uint64_t &flips) {
+  flips = color == Color::BLACK ? getFlips(board.black_bb, board.white_bb, move)
+                                : getFlips(board.white_bb, board.black_bb, move);
+  return makeMove(board, move, color, flips);
+}
+
+/// @brief The position after a move from a move list, reusing the flips
+///        move ordering computed if it did
+GameBoard playMove(const GameBoard &board, const MoveList &moves, int move,
+                   Color color, uint64_t &flips) {
+  flips = moves.flips(move);
+  if (flips == 0) {
+    return playMove(board, move, color, flips);
+  }
+  return makeMove(board, move, color, flips);
+}
+
+/// @brief Return the ordered root moves
+/// @param hash_move The root's best move stored in the transposition table,
+///        or -1
+std::vector<int> orderRootMoves(const GameBoard &board, uint64_t moves_bb,
+                                Color color, int hash_move) {
+  MoveList list;
+  scoreMoves(board, moves_bb, color, hash_move, true, nullptr, nullptr, list);
+  list.sortFrom(0);
+  std::vector<int> moves;
+  moves.reserve(list.size());
+  for (size_t i = 0; i < list.size(); ++i) {
+    moves.push_back(list[i].square);
   }
   return moves;
 }
 
+/// Index of color in SearchContext::history
+int colorIndex(Color color) { return color == Color::BLACK ? 0 : 1; }
+
 } // namespace
+
+void Engine::SearchContext::clear() {
+  for (auto &slots : killers) {
+    slots.fill(-1);
+  }
+  for (auto &scores : history) {
+    scores.fill(0);
+  }
+}
+
+void Engine::SearchContext::age() {
+  for (auto &scores : history) {
+    for (int32_t &score : scores) {
+      score >>= 1;
+    }
+  }
+}
+
+void Engine::SearchContext::recordCutoff(int ply, Color color, int move,
+                                         uint8_t depth) {
+  if (ply < kMaxPly && killers[ply][0] != move) {
+    killers[ply][1] = killers[ply][0];
+    killers[ply][0] = static_cast<int8_t>(move);
+  }
+  auto &scores = history[colorIndex(color)];
+  scores[move] += static_cast<int32_t>(depth) * depth;
+  if (scores[move] > kHistoryMax) {
+    for (int32_t &score : scores) {
+      score >>= 1;
+    }
+  }
+}
+
+Engine::SearchContext &Engine::threadContext() {
+  SearchContext *context;
+  const int worker = thread_pool.workerIndex();
+  if (worker >= 0) {
+    context = &contexts[static_cast<size_t>(worker) + 1];
+  } else if (std::this_thread::get_id() == search_thread) {
+    context = &contexts[0];
+  } else {
+    // A thread outside the pool that is helping out while it waits for
+    // another engine's search. Its tables are only ordering hints, so they
+    // don't need to belong to this engine.
+    thread_local SearchContext scratch;
+    context = &scratch;
+  }
+  const uint32_t current = iteration.load(std::memory_order_relaxed);
+  if (context->aged_iteration != current) {
+    context->age();
+    context->aged_iteration = current;
+  }
+  return *context;
+}
+
+void Engine::newGame() {
+  transposition_table.clear();
+  endgame_solver.clear();
+  for (SearchContext &context : contexts) {
+    context.clear();
+  }
+}
+
+int Engine::findBestMove(const GameBoard &board, uint8_t max_depth, Color color,
+                         int time_limit_ms,
+                         const StopCondition &stop_condition) {
+  // A flat limit: iterations start until it has passed
+  TimeManager time({time_limit_ms, time_limit_ms}, false);
+  return findBestMove(board, max_depth, color, time, stop_condition);
+}
+
 int Engine::findBestMove(const GameBoard &board, uint8_t max_depth, Color color,
-                         int time_limit_ms) {
+                         TimeManager &time,
+                         const StopCondition &stop_condition,
+                         const IterationCallback &on_iteration) {
   const auto start_time = std::chrono::steady_clock::now();
-  last_stats = SearchStats{};
+  const StopConditionReset reset_stop =
+      beginSearch(start_time, time, stop_condition);
 
   uint64_t bb = getPossibleMoves(board, color);
   if (!bb) {
     return -1;
   }
 
-  // One TT per root move (reused across depths)
-  std::vector<TT> tt_per_move(std::popcount(bb));
-  for (auto &tt : tt_per_move)
-    tt.reserve(1 << 19); // tune this
+  if (opening_book != nullptr) {
+    const std::optional<BookMove> book_move = opening_book->probe(board, color);
+    // A legal move guards against the odd key collision
+    if (book_move && ((bb >> book_move->move) & 1)) {
+      last_stats.best_move = book_move->move;
+      last_stats.score = book_move->score;
+      last_stats.completed_depth = book_move->depth;
+      last_stats.book_hit = true;
+      return book_move->move;
+    }
+  }
+
+  const int empties = 64 - std::popcount(board.black_bb | board.white_bb);
+  if (empties <= endgame_empties) {
+    return solveEndgame(board, color, [this] {
+      pollStop();
+      return search_stop.cutoff.load(std::memory_order_relaxed);
+    });
+  }
+
+  // Keep results from earlier searches; they age out through replacement.
+  transposition_table.newSearch();
 
-  std::vector<int> moves = order_moves(bb, tt_per_move[0], board.zobrist_hash);
+  const NodeKey root_key = nodeKey(board, color);
+  TTEntry root_entry;
+  const int root_hash_move =
+      transposition_table.probe(root_key.key, root_entry) &&
+              root_entry.move_index >= 0
+          ? untransformSquare(root_entry.move_index, root_key.symmetry)
+          : -1;
+  std::vector<int> moves = orderRootMoves(board, bb, color, root_hash_move);
 
   std::pair<int, int> best_pair{-INF, -1};
+  int previous_score = -INF; // Score of the iteration before best_pair's
 
-  cacheHits = 0;
-  nodesSearched = 0;
-  for (int depth = 1; depth <= max_depth; ++depth) {
+  // Lazy SMP: up to helper_threads pool workers run their own iterative
+  // deepening loops over the shared TT until this thread finishes; they are stopped through a
+  // split point that is never searched, only cut off.
+  SplitPoint helpers_stop{&search_stop, {-INF}, INF, {false}, {0}};
+  std::array<utils::Task, 64> helper_tasks;
+  utils::TaskGroup helpers;
+  const std::vector<int> root_moves = moves; // moves is reordered below
+  if (search_mode == SearchMode::LAZY_SMP) {
+    const size_t helper_count = std::min(
+        {helper_threads, thread_pool.size(), helper_tasks.size()});
+    for (size_t h = 0; h < helper_count; ++h) {
+      helper_tasks[h].emplace([this, &board, &root_moves, &helpers_stop,
+                               max_depth, color, h]() {
+        lazySmpHelper(board, root_moves, max_depth, color, h + 1,
+                      helpers_stop);
+      });
+      thread_pool.spawn(helpers, helper_tasks[h]);
+    }
+  }
 
-    auto elapsed_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                          std::chrono::steady_clock::now() - start_time)
-                          .count();
-    if (elapsed_ms >= time_limit_ms) {
+  auto elapsed_ms = [&start_time] {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start_time)
+        .count();
+  };
+  for (int depth = 1; depth <= max_depth; ++depth) {
+    if (!time.startIteration(elapsed_ms())) {
       last_stats.time_limit_hit = true;
       if (verbose) {
         std::cout << "Time limit reached at depth " << (depth - 1)
@@ -91,69 +289,75 @@ int Engine::findBestMove(const GameBoard &board, uint8_t max_depth, Color color,
       }
       break;
     }
+    const uint64_t nodes_before = nodesSearched.load(std::memory_order_relaxed);
 
-    std::atomic<int> alpha{-INF};
-    const int beta = INF;
-
-    // YBW seed
-    std::pair<int, int> depth_best;
-    {
-      GameBoard child = applyMove(board, moves[0], color);
-      auto &tt0 = tt_per_move[0];
-      auto r =
-          negamax(child, tt0, depth - 1, -beta, -alpha.load(), opponent(color));
-      int root_score = -r.first;
-      int cur = alpha.load();
-      while (root_score > cur &&
-             !alpha.compare_exchange_weak(cur, root_score)) {
+    iteration.fetch_add(1, std::memory_order_relaxed);
+    // Scores alternate between odd and even depths, so guess from the last
+    // iteration of the same parity when there is one.
+    const int guess = depth > 2 ? previous_score : best_pair.first;
+    const std::pair<int, int> depth_best =
+        searchIteration(board, moves, depth, color, guess);
+    if (search_stop.aborted()) {
+      // moves[0] is the last iteration's best move, so a different move
+      // here was proved better at the deeper depth
+      if (depth_best.second >= 0 && depth_best.second != best_pair.second) {
+        best_pair = depth_best;
       }
-      depth_best = {root_score, moves[0]};
+      break;
     }
 
-    // Parallel brothers
-    std::vector<std::future<std::pair<int, int>>> futs;
-    futs.reserve(moves.size() > 0 ? moves.size() - 1 : 0);
-
-    for (size_t i = 1; i < moves.size(); ++i) {
-      int mv = moves[i];
-      GameBoard child = applyMove(board, mv, color);
-      TT *tt = &tt_per_move[i]; // stable address; safe to capture
-
-      futs.push_back(thread_pool.enqueue([=, this, &alpha]() {
-        int a = alpha.load(std::memory_order_relaxed);
-
-        // Scout search (zero window)
-        auto pr = negamax(child, *tt, depth - 1, -a - 1, -a, opponent(color));
-        int probe = -pr.first;
+    previous_score = best_pair.first;
+    best_pair = depth_best;
+    last_stats.completed_depth = depth;
+    time.iterationCompleted(
+        best_pair.second,
+        nodesSearched.load(std::memory_order_relaxed) - nodes_before,
+        elapsed_ms());
+    if (on_iteration) {
+      on_iteration(IterationReport{
+          .depth = depth,
+          .best_move = best_pair.second,
+          .score = best_pair.first,
+          .principal_variation =
+              principalVariation(board, color, best_pair.second, depth),
+          .nodes_searched = nodesSearched.load(std::memory_order_relaxed),
+          .cache_hits = static_cast<uint64_t>(cacheHits.load()),
+          .elapsed_ms = elapsed_ms(),
+          .solved = false,
+          .lines = {},
+      });
+    }
 
-        int score;
-        if (probe > a) {
-          // Re-search with full window
-          auto fr = negamax(child, *tt, depth - 1, -INF, -a, opponent(color));
-          score = -fr.first;
-        } else {
-          score = probe;
-        }
+    // Search the best move of this iteration first in the next one
+    auto best_it = std::find(moves.begin(), moves.end(), best_pair.second);
+    std::rotate(moves.begin(), best_it, best_it + 1);
+  }
 
-        // Raise shared alpha
-        int cur = alpha.load(std::memory_order_relaxed);
-        while (score > cur && !alpha.compare_exchange_weak(cur, score)) {
-        }
-        return std::make_pair(score, mv);
-      }));
+  if (search_mode == SearchMode::LAZY_SMP) {
+    helpers_stop.cutoff.store(true, std::memory_order_relaxed);
+    thread_pool.wait(helpers);
+  }
+  if (search_stop.aborted()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      last_stats.time_limit_hit = true;
+    } else {
+      last_stats.stopped = true;
     }
-    for (auto &f : futs) {
-      auto res = f.get();
-      if (res.first > depth_best.first) {
-        depth_best = res;
-      }
+    if (verbose) {
+      std::cout << "Search stopped during depth "
+                << (last_stats.completed_depth + 1) << std::endl;
     }
-
-    best_pair = depth_best;
-    last_stats.completed_depth = depth;
   }
+  if (best_pair.second < 0) {
+    // Stopped before the first iteration finished: trust the move ordering
+    best_pair.second = moves[0];
+  }
+
   last_stats.nodes_searched = nodesSearched.load();
   last_stats.cache_hits = cacheHits.load();
+  last_stats.cutoffs = cutoffs.load();
+  last_stats.root_searches = root_searches;
+  last_stats.first_move_cutoffs = firstMoveCutoffs.load();
   last_stats.best_move = best_pair.second;
   last_stats.score = last_stats.completed_depth > 0 ? best_pair.first : 0;
   if (verbose) {
@@ -165,14 +369,711 @@ int Engine::findBestMove(const GameBoard &board, uint8_t max_depth, Color color,
   return best_pair.second;
 }
 
+std::vector<RootLine> Engine::analyzeRootMoves(
+    const GameBoard &board, uint8_t max_depth, Color color, size_t line_count,
+    TimeManager &time, const StopCondition &stop_condition,
+    const IterationCallback &on_iteration) {
+  const auto start_time = std::chrono::steady_clock::now();
+  const StopConditionReset reset_stop =
+      beginSearch(start_time, time, stop_condition);
+
+  const uint64_t bb = getPossibleMoves(board, color);
+  if (!bb) {
+    return {};
+  }
+  const int empties = 64 - std::popcount(board.black_bb | board.white_bb);
+  const bool solve = empties <= endgame_empties;
+  if (solve) {
+    endgame_solver.newSearch();
+    max_depth = static_cast<uint8_t>(empties);
+  } else {
+    transposition_table.newSearch();
+  }
+  line_count = std::clamp<size_t>(line_count, 1, std::popcount(bb));
+
+  const NodeKey root_key = nodeKey(board, color);
+  TTEntry root_entry;
+  const int root_hash_move =
+      transposition_table.probe(root_key.key, root_entry) &&
+              root_entry.move_index >= 0
+          ? untransformSquare(root_entry.move_index, root_key.symmetry)
+          : -1;
+  std::vector<RootLine> lines;
+  for (int move : orderRootMoves(board, bb, color, root_hash_move)) {
+    lines.push_back({move, -INF, {move}});
+  }
+  std::vector<RootLine> best_lines;
+
+  auto elapsed_ms = [&start_time] {
+    return std::chrono::duration<double, std::milli>(
+               std::chrono::steady_clock::now() - start_time)
+        .count();
+  };
+  // The solver makes a single pass, stopped like the others only from inside
+  for (int depth = solve ? max_depth : 1; depth <= max_depth; ++depth) {
+    if (!solve && !time.startIteration(elapsed_ms())) {
+      last_stats.time_limit_hit = true;
+      break;
+    }
+    const uint64_t nodes_before = nodesSearched.load(std::memory_order_relaxed);
+    iteration.fetch_add(1, std::memory_order_relaxed);
+    if (!searchRootLines(board, lines, static_cast<uint8_t>(depth), color,
+                         line_count, solve)) {
+      break;
+    }
+
+    best_lines.assign(lines.begin(), lines.begin() + line_count);
+    last_stats.completed_depth = depth;
+    time.iterationCompleted(
+        lines[0].move,
+        nodesSearched.load(std::memory_order_relaxed) - nodes_before,
+        elapsed_ms());
+    if (on_iteration) {
+      on_iteration(IterationReport{
+          .depth = depth,
+          .best_move = best_lines[0].move,
+          .score = best_lines[0].score,
+          .principal_variation = best_lines[0].principal_variation,
+          .nodes_searched = nodesSearched.load(std::memory_order_relaxed),
+          .cache_hits = static_cast<uint64_t>(cacheHits.load()),
+          .elapsed_ms = elapsed_ms(),
+          .solved = solve,
+          .lines = best_lines,
+      });
+    }
+  }
+
+  if (search_stop.aborted()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      last_stats.time_limit_hit = true;
+    } else {
+      last_stats.stopped = true;
+    }
+  }
+
+  last_stats.nodes_searched = nodesSearched.load();
+  last_stats.cache_hits = cacheHits.load();
+  last_stats.cutoffs = cutoffs.load();
+  last_stats.root_searches = root_searches;
+  last_stats.first_move_cutoffs = firstMoveCutoffs.load();
+  last_stats.best_move = best_lines.empty() ? lines[0].move
+                                            : best_lines[0].move;
+  last_stats.score = best_lines.empty() ? 0 : best_lines[0].score;
+  last_stats.solved = solve && !best_lines.empty();
+  return best_lines;
+}
+
+bool Engine::searchRootLines(const GameBoard &board,
+                             std::vector<RootLine> &lines, uint8_t depth,
+                             Color color, size_t line_count, bool solve) {
+  ++root_searches;
+  EvalAccumulator root_accumulator;
+  resetAccumulator(board, root_accumulator);
+  std::vector<GameBoard> children;
+  children.reserve(lines.size());
+  std::array<EvalAccumulator, 64> accumulators;
+  for (size_t i = 0; i < lines.size(); ++i) {
+    uint64_t flips;
+    children.push_back(playMove(board, lines[i].move, color, flips));
+    advance(root_accumulator, lines[i].move, flips, color, accumulators[i]);
+  }
+
+  // Moves scoring above threshold are scored exactly. Once line_count moves
+  // have been, it is the lowest of the line_count best scores.
+  std::atomic<int> threshold{-INF};
+  std::mutex best_mutex;
+  std::vector<int> best_scores; // Min-heap of at most line_count scores
+  std::array<int, 64> scores;
+  std::array<bool, 64> exact{};
+  auto search = [&, depth, color, solve](size_t i) {
+    const int bound = threshold.load(std::memory_order_relaxed);
+    int score;
+    if (solve) {
+      // The solver scores discs; our scores are hundredths of discs
+      const GameBoard &child = children[i];
+      const uint64_t player =
+          color == Color::BLACK ? child.white_bb : child.black_bb;
+      const uint64_t opponent_bb =
+          color == Color::BLACK ? child.black_bb : child.white_bb;
+      const int disc_bound =
+          bound == -INF ? -kMaxEndgameScore - 1 : bound / 100;
+      uint64_t nodes = 0;
+      score = -100 * endgame_solver.solve(
+                         player, opponent_bb, -kMaxEndgameScore - 1,
+                         -disc_bound, nodes, [this] {
+                           pollStop();
+                           return search_stop.cutoff.load(
+                               std::memory_order_relaxed);
+                         });
+      nodesSearched.fetch_add(nodes, std::memory_order_relaxed);
+    } else {
+      score = -negamax(children[i], accumulators[i], depth - 1, -INF, -bound,
+                       opponent(color), threadContext(), 1, &search_stop)
+                   .first;
+    }
+    if (search_stop.aborted()) {
+      return;
+    }
+    scores[i] = score;
+    exact[i] = score > bound;
+    if (exact[i]) {
+      std::lock_guard<std::mutex> lock(best_mutex);
+      best_scores.push_back(score);
+      std::push_heap(best_scores.begin(), best_scores.end(), std::greater<>());
+      if (best_scores.size() > line_count) {
+        std::pop_heap(best_scores.begin(), best_scores.end(), std::greater<>());
+        best_scores.pop_back();
+      }
+      if (best_scores.size() == line_count) {
+        threshold.store(best_scores.front(), std::memory_order_relaxed);
+      }
+    }
+  };
+
+  // The previous best lines first, with full windows, then the challengers
+  // against the threshold they set
+  std::array<utils::Task, 64> tasks;
+  for (const auto &[first, last] :
+       {std::pair<size_t, size_t>{0, line_count}, {line_count, lines.size()}}) {
+    utils::TaskGroup group;
+    for (size_t i = first; i < last; ++i) {
+      tasks[i].emplace([&search, i]() { search(i); });
+      thread_pool.spawn(group, tasks[i]);
+    }
+    thread_pool.wait(group);
+    if (search_stop.aborted()) {
+      return false;
+    }
+  }
+
+  for (size_t i = 0; i < lines.size(); ++i) {
+    lines[i].score = scores[i];
+    if (!exact[i]) {
+      lines[i].principal_variation = {lines[i].move};
+    } else if (solve) {
+      // The solver keeps no best moves to follow
+      lines[i].principal_variation = {lines[i].move};
+    } else {
+      lines[i].principal_variation =
+          principalVariation(board, color, lines[i].move, depth);
+    }
+  }
+  // Exactly scored moves first; a move can be scored exactly and still drop
+  // out of the lines when later moves raise the threshold past it
+  std::vector<size_t> order(lines.size());
+  for (size_t i = 0; i < order.size(); ++i) {
+    order[i] = i;
+  }
+  std::stable_sort(order.begin(), order.end(), [&](size_t a, size_t b) {
+    if (exact[a] != exact[b]) {
+      return exact[a];
+    }
+    return scores[a] > scores[b];
+  });
+  std::vector<RootLine> ranked;
+  ranked.reserve(lines.size());
+  for (size_t i : order) {
+    ranked.push_back(std::move(lines[i]));
+  }
+  lines = std::move(ranked);
+  return true;
+}
+
+int Engine::solveEndgame(const GameBoard &board, Color color) {
+  return solveEndgame(board, color, {});
+}
+
+int Engine::solveEndgame(const GameBoard &board, Color color,
+                         const SolveAbort &abort) {
+  last_stats = SearchStats{};
+  const uint64_t player =
+      color == Color::BLACK ? board.black_bb : board.white_bb;
+  const uint64_t opponent_bb =
+      color == Color::BLACK ? board.white_bb : board.black_bb;
+  uint64_t moves_bb = getMoves(player, opponent_bb);
+  if (!moves_bb) {
+    return -1;
+  }
+  endgame_solver.newSearch();
+
+  // Fastest-first at the root too: fewest opponent replies first
+  struct RootMove {
+    int square;
+    int replies;
+    uint64_t next_player;
+    uint64_t next_opponent;
+  };
+  std::array<RootMove, 64> moves;
+  size_t move_count = 0;
+  for (; moves_bb; moves_bb &= moves_bb - 1) {
+    const int square = std::countr_zero(moves_bb);
+    const uint64_t flips = getFlips(player, opponent_bb, square);
+    const uint64_t next_player = opponent_bb ^ flips;
+    const uint64_t next_opponent = player | flips | (1ULL << square);
+    moves[move_count++] = {
+        square, std::popcount(getMoves(next_player, next_opponent)),
+        next_player, next_opponent};
+  }
+  std::sort(moves.begin(), moves.begin() + move_count,
+            [](const RootMove &a, const RootMove &b) {
+              return a.replies < b.replies;
+            });
+
+  // YBW seed: the first move is solved with the full window. A solve that
+  // returns once abort has fired may have been cut short, and abort never
+  // fires again after a stop, so checking it afterwards tells them apart.
+  auto stopped = [this, &abort] {
+    return abort && search_stop.cutoff.load(std::memory_order_relaxed);
+  };
+  uint64_t nodes = 0;
+  const int beta = kMaxEndgameScore + 1;
+  const int first = -endgame_solver.solve(moves[0].next_player,
+                                          moves[0].next_opponent, -beta, beta,
+                                          nodes, abort);
+  const bool first_solved = !stopped();
+  std::atomic<int> alpha{first};
+  std::atomic<uint64_t> total_nodes{nodes};
+
+  std::array<utils::Task, 64> tasks;
+  std::array<int, 64> results;
+  std::array<bool, 64> solved{};
+  utils::TaskGroup brothers;
+  for (size_t i = 1; first_solved && i < move_count; ++i) {
+    tasks[i].emplace([this, &moves, &results, &solved, &alpha, &total_nodes,
+                      &abort, &stopped, beta, i]() {
+      if (stopped()) {
+        return;
+      }
+      const RootMove &move = moves[i];
+      uint64_t task_nodes = 0;
+      const int a = alpha.load(std::memory_order_relaxed);
+      // Null window: only an improvement needs an exact score
+      int score = -endgame_solver.solve(move.next_player, move.next_opponent,
+                                        -a - 1, -a, task_nodes, abort);
+      if (score > a && !stopped()) {
+        score = -endgame_solver.solve(move.next_player, move.next_opponent,
+                                      -beta, -a, task_nodes, abort);
+      }
+      total_nodes.fetch_add(task_nodes, std::memory_order_relaxed);
+      if (stopped()) {
+        return;
+      }
+      int cur = alpha.load(std::memory_order_relaxed);
+      while (score > cur && !alpha.compare_exchange_weak(cur, score)) {
+      }
+      results[i] = score;
+      solved[i] = true;
+    });
+    if (search_mode == SearchMode::SERIAL) {
+      tasks[i]();
+    } else {
+      thread_pool.spawn(brothers, tasks[i]);
+    }
+  }
+  thread_pool.wait(brothers);
+
+  last_stats.nodes_searched = total_nodes.load();
+  if (stopped()) {
+    if (std::chrono::steady_clock::now() >= deadline) {
+      last_stats.time_limit_hit = true;
+    } else {
+      last_stats.stopped = true;
+    }
+  }
+  if (!first_solved) {
+    // Nothing proved: trust the heuristic move ordering
+    const int best_move =
+        orderRootMoves(board, getPossibleMoves(board, color), color, -1)[0];
+    last_stats.best_move = best_move;
+    if (verbose) {
+      std::cout << "Endgame solve stopped | Best move: " << best_move
+                << std::endl;
+    }
+    return best_move;
+  }
+
+  // Brothers cut short are skipped; the rest either failed low against a
+  // score already proved or were solved exactly
+  int best_score = first;
+  int best_move = moves[0].square;
+  for (size_t i = 1; i < move_count; ++i) {
+    if (solved[i] && results[i] > best_score) {
+      best_score = results[i];
+      best_move = moves[i].square;
+    }
+  }
+
+  last_stats.best_move = best_move;
+  last_stats.score = 100 * best_score;
+  if (stopped()) {
+    if (verbose) {
+      std::cout << "Endgame solve stopped | Best move: " << best_move
+                << " | Final disc difference at least: " << best_score
+                << std::endl;
+    }
+    return best_move;
+  }
+  last_stats.completed_depth =
+      64 - std::popcount(board.black_bb | board.white_bb);
+  last_stats.solved = true;
+  if (verbose) {
+    std::cout << "Endgame solved | Nodes searched: "
+              << last_stats.nodes_searched << std::endl;
+    std::cout << "Best move: " << best_move << " | Final disc difference: "
+              << best_score << std::endl;
+  }
+  return best_move;
+}
+
+std::pair<int, int> Engine::searchIteration(const GameBoard &board,
+                                            const std::vector<int> &moves,
+                                            uint8_t depth, Color color,
+                                            int guess) {
+  if (depth == 1 || search_driver == SearchDriver::FULL_WINDOW) {
+    return searchRoot(board, moves, depth, color, -INF, INF);
+  }
+  if (search_driver == SearchDriver::MTDF) {
+    return searchMtdf(board, moves, depth, color, guess);
+  }
+  return searchAspiration(board, moves, depth, color, guess);
+}
+
+std::pair<int, int> Engine::searchAspiration(const GameBoard &board,
+                                             const std::vector<int> &moves,
+                                             uint8_t depth, Color color,
+                                             int guess) {
+  int delta = kAspirationDelta;
+  int alpha = guess - delta;
+  int beta = guess + delta;
+  std::pair<int, int> failed_high{-INF, -1}; // Its move is proved best so far
+  while (true) {
+    const std::pair<int, int> result =
+        searchRoot(board, moves, depth, color, alpha, beta);
+    if (search_stop.aborted()) {
+      return result.second >= 0 ? result : failed_high;
+    }
+    if (result.first > alpha && result.first < beta) {
+      return result;
+    }
+    if (result.first >= beta) {
+      failed_high = result;
+    }
+    // Widen the failing side around the bound we learned; after a few
+    // stages the window is unbounded on that side and cannot fail again.
+    delta *= 4;
+    if (result.first <= alpha) {
+      alpha = delta > INF / 4 ? -INF : std::max(-INF, result.first - delta);
+    } else {
+      beta = delta > INF / 4 ? INF : std::min(INF, result.first + delta);
+    }
+  }
+}
+
+std::pair<int, int> Engine::searchMtdf(const GameBoard &board,
+                                       const std::vector<int> &moves,
+                                       uint8_t depth, Color color, int guess) {
+  int lower = -INF;
+  int upper = INF;
+  std::pair<int, int> best{guess, moves[0]};
+  while (lower < upper) {
+    const int beta = best.first == lower ? best.first + 1 : best.first;
+    const std::pair<int, int> result =
+        searchRoot(board, moves, depth, color, beta - 1, beta);
+    if (search_stop.aborted()) {
+      return result.second >= 0 ? result : best;
+    }
+    if (result.first < beta) {
+      upper = result.first;
+      best.first = result.first;
+    } else {
+      // Only a search that fails high identifies a best move
+      lower = result.first;
+      best = result;
+    }
+  }
+  return best;
+}
+
+std::pair<int, int> Engine::searchRoot(const GameBoard &board,
+                                       const std::vector<int> &moves,
+                                       uint8_t depth, Color color, int alpha,
+                                       int beta) {
+  ++root_searches;
+  return search_mode == SearchMode::YBWC
+             ? searchRootParallel(board, moves, depth, color, alpha, beta)
+             : searchRootSerial(board, moves, depth, color, alpha, beta,
+                                &search_stop);
+}
+
+std::pair<int, int> Engine::searchRootParallel(const GameBoard &board,
+                                               const std::vector<int> &moves,
+                                               uint8_t depth, Color color,
+                                               int alpha_bound, int beta) {
+  std::atomic<int> alpha{alpha_bound};
+  EvalAccumulator root_accumulator;
+  resetAccumulator(board, root_accumulator);
+
+  // YBW seed
+  std::pair<int, int> depth_best;
+  {
+    uint64_t flips;
+    GameBoard child = playMove(board, moves[0], color, flips);
+    EvalAccumulator child_accumulator;
+    advance(root_accumulator, moves[0], flips, color, child_accumulator);
+    auto r = negamax(child, child_accumulator, depth - 1, -beta, -alpha_bound,
+                     opponent(color), threadContext(), 1, &search_stop);
+    if (search_stop.aborted()) {
+      return {-INF, -1};
+    }
+    int root_score = -r.first;
+    int cur = alpha.load();
+    while (root_score > cur && !alpha.compare_exchange_weak(cur, root_score)) {
+    }
+    depth_best = {root_score, moves[0]};
+    if (root_score >= beta) {
+      return depth_best; // Fail high: the brothers can't change the outcome
+    }
+  }
+
+  // Parallel brothers. Tasks and results live on this stack frame until
+  // the group has been waited on, so spawning them does not allocate.
+  std::array<utils::Task, 64> tasks;
+  std::array<std::pair<int, int>, 64> results;
+  std::array<EvalAccumulator, 64> accumulators;
+  utils::TaskGroup brothers;
+
+  for (size_t i = 1; i < moves.size(); ++i) {
+    int mv = moves[i];
+    uint64_t flips;
+    GameBoard child = playMove(board, mv, color, flips);
+    advance(root_accumulator, mv, flips, color, accumulators[i]);
+    const EvalAccumulator *child_accumulator = &accumulators[i];
+    std::pair<int, int> *result = &results[i];
+
+    tasks[i].emplace([=, this, &alpha]() {
+      int a = alpha.load(std::memory_order_relaxed);
+      if (a >= beta) {
+        // A brother already failed high
+        *result = std::make_pair(-INF, mv);
+        return;
+      }
+      SearchContext &ctx = threadContext();
+
+      // Scout search (zero window)
+      auto pr = negamax(child, *child_accumulator, depth - 1, -a - 1, -a,
+                        opponent(color), ctx, 1, &search_stop);
+      int probe = -pr.first;
+
+      int score;
+      if (probe > a && probe < beta) {
+        // Re-search with the rest of the window
+        auto fr = negamax(child, *child_accumulator, depth - 1, -beta, -a,
+                          opponent(color), ctx, 1, &search_stop);
+        score = -fr.first;
+      } else {
+        score = probe;
+      }
+      if (search_stop.aborted()) {
+        // Incomplete, and perhaps from an aborted node; never use it
+        *result = std::make_pair(-INF, mv);
+        return;
+      }
+
+      // Raise shared alpha
+      int cur = alpha.load(std::memory_order_relaxed);
+      while (score > cur && !alpha.compare_exchange_weak(cur, score)) {
+      }
+      *result = std::make_pair(score, mv);
+    });
+    thread_pool.spawn(brothers, tasks[i]);
+  }
+  thread_pool.wait(brothers);
+  for (size_t i = 1; i < moves.size(); ++i) {
+    if (results[i].first > depth_best.first) {
+      depth_best = results[i];
+    }
+  }
+  // Once stopped, only completed moves were kept; a score above alpha is a
+  // lower bound, so that move is proved at least as good as any other kept.
+  if (search_stop.aborted() && depth_best.first <= alpha_bound) {
+    return {-INF, -1};
+  }
+  return depth_best;
+}
+
+std::pair<int, int> Engine::searchRootSerial(const GameBoard &board,
+                                             const std::vector<int> &moves,
+                                             uint8_t depth, Color color,
+                                             int alpha_bound, int beta,
+                                             const SplitPoint *stop) {
+  SearchContext &ctx = threadContext();
+  EvalAccumulator root_accumulator;
+  resetAccumulator(board, root_accumulator);
+  int alpha = alpha_bound;
+  std::pair<int, int> depth_best{-INF, -1};
+  for (size_t i = 0; i < moves.size(); ++i) {
+    uint64_t flips;
+    const GameBoard child = playMove(board, moves[i], color, flips);
+    EvalAccumulator accumulator;
+    advance(root_accumulator, moves[i], flips, color, accumulator);
+    int score;
+    if (i == 0) {
+      score = -negamax(child, accumulator, depth - 1, -beta, -alpha,
+                       opponent(color), ctx, 1, stop)
+                   .first;
+    } else {
+      // PVS: scout (zero-window) first, re-search on fail-high
+      score = -negamax(child, accumulator, depth - 1, -alpha - 1, -alpha,
+                       opponent(color), ctx, 1, stop)
+                   .first;
+      if (score > alpha && score < beta) {
+        score = -negamax(child, accumulator, depth - 1, -beta, -alpha,
+                         opponent(color), ctx, 1, stop)
+                     .first;
+      }
+    }
+    if (stop != nullptr && stop->aborted()) {
+      // As in searchRootParallel, keep only a move proved best so far
+      return depth_best.first > alpha_bound ? depth_best
+                                            : std::make_pair(-INF, -1);
+    }
+    if (score > depth_best.first) {
+      depth_best = {score, moves[i]};
+    }
+    alpha = std::max(alpha, score);
+    if (alpha >= beta) {
+      break;
+    }
+  }
+  return depth_best;
+}
+
+void Engine::lazySmpHelper(const GameBoard &board, std::vector<int> moves,
+                           uint8_t max_depth, Color color, size_t helper_id,
+                           const SplitPoint &stop) {
+  if (utils::ThreadPool::insideWait()) {
+    return;
+  }
+  // Perturb the helper so it does not duplicate the main thread exactly:
+  // odd helpers run one ply ahead, and each helper tries a different root
+  // move right after the principal one.
+  if (moves.size() > 2) {
+    const size_t offset = 1 + helper_id % (moves.size() - 1);
+    std::rotate(moves.begin() + 1, moves.begin() + offset, moves.end());
+  }
+  for (int depth = 1 + static_cast<int>(helper_id & 1); depth <= max_depth;
+       ++depth) {
+    searchRootSerial(board, moves, static_cast<uint8_t>(depth), color, -INF,
+                     INF, &stop);
+    if (stop.aborted()) {
+      return;
+    }
+  }
+}
+
+Engine::NodeKey Engine::nodeKey(const GameBoard &board, Color color) const {
+  if (std::popcount(board.black_bb | board.white_bb) > canonical_discs) {
+    return {board.zobrist_hash, 0};
+  }
+  const CanonicalBoards canonical =
+      canonicalize(board.black_bb, board.white_bb);
+  return {mixBitboards(canonical.first, canonical.second) ^
+              (color == Color::BLACK ? zobrist_black_turn : 0),
+          canonical.symmetry};
+}
+
+Engine::StopConditionReset
+Engine::beginSearch(std::chrono::steady_clock::time_point start,
+                    const TimeManager &time,
+                    const StopCondition &stop_condition) {
+  last_stats = SearchStats{};
+  search_stop.cutoff.store(false, std::memory_order_relaxed);
+  deadline =
+      start + std::chrono::milliseconds(std::max(time.budget().hard_ms, 0));
+  this->stop_condition = stop_condition ? &stop_condition : nullptr;
+  cacheHits = 0;
+  nodesSearched = 0;
+  cutoffs = 0;
+  firstMoveCutoffs = 0;
+  root_searches = 0;
+  search_thread = std::this_thread::get_id();
+  return StopConditionReset(*this);
+}
+
+void Engine::pollStop() {
+  if (std::chrono::steady_clock::now() >= deadline ||
+      (stop_condition != nullptr && (*stop_condition)())) {
+    search_stop.cutoff.store(true, std::memory_order_relaxed);
+  }
+}
+
+std::vector<int> Engine::principalVariation(const GameBoard &board,
+                                            Color color, int move,
+                                            int max_length) const {
+  std::vector<int> line{move};
+  uint64_t flips;
+  GameBoard position = playMove(board, move, color, flips);
+  color = opponent(color);
+  while (static_cast<int>(line.size()) < max_length) {
+    const uint64_t moves = getPossibleMoves(position, color);
+    if (moves == 0) {
+      if (getPossibleMoves(position, opponent(color)) == 0) {
+        break; // Game over
+      }
+      line.push_back(-1);
+      position = passTurn(position);
+      color = opponent(color);
+      continue;
+    }
+    const NodeKey key = nodeKey(position, color);
+    TTEntry entry;
+    if (!transposition_table.probe(key.key, entry) || entry.move_index < 0) {
+      break;
+    }
+    const int next = key.symmetry != 0
+                         ? untransformSquare(entry.move_index, key.symmetry)
+                         : entry.move_index;
+    if (!((moves >> next) & 1)) {
+      break; // A colliding entry
+    }
+    line.push_back(next);
+    position = playMove(position, next, color, flips);
+    color = opponent(color);
+  }
+  if (line.back() < 0) {
+    line.pop_back(); // A pass into a line the table knows nothing about
+  }
+  return line;
+}
+
+bool Engine::SplitPoint::aborted() const {
+  for (const SplitPoint *sp = this; sp != nullptr; sp = sp->parent) {
+    if (sp->cutoff.load(std::memory_order_relaxed)) {
+      return true;
+    }
+  }
+  return false;
+}
+
 std::pair<int, int8_t>
-Engine::negamax(const GameBoard &board,
-                TT &transposition_table,
-                uint8_t depth, int alpha, int beta, Color color) {
+Engine::negamax(const GameBoard &board, const EvalAccumulator &accumulator,
+                uint8_t depth, int alpha, int beta, Color color,
+                SearchContext &ctx, int ply, const SplitPoint *split,
+                uint64_t legal_moves_bb) {
+  // A sibling already refuted the split point this node belongs to; the
+  // result will be discarded, so stop as early as possible.
+  if (split != nullptr && split->aborted()) {
+    return {0, -1};
+  }
   int alpha_orig = alpha;
-  auto it = transposition_table.find(board.zobrist_hash);
-  if (it != transposition_table.end()) {
-    const TTEntry &entry = it->second;
+  int8_t hash_move = -1;
+  const NodeKey key = nodeKey(board, color);
+  TTEntry entry;
+  if (transposition_table.probe(key.key, entry)) {
+    if (key.symmetry != 0 && entry.move_index >= 0) {
+      entry.move_index = static_cast<int8_t>(
+          untransformSquare(entry.move_index, key.symmetry));
+    }
     if (entry.depth >= depth) {
       // Use the stored value if it's valid for the current depth and bounds
       if (entry.bound_type == BoundType::EXACT ||
@@ -182,15 +1083,33 @@ Engine::negamax(const GameBoard &board,
         return {entry.score, entry.move_index};
       }
     }
+    // Not enough for a cutoff, but the stored move is still the best guess
+    hash_move = entry.move_index;
   }
   ++nodesSearched;
+  if (--ctx.nodes_until_poll == 0) {
+    ctx.nodes_until_poll = kStopPollNodes;
+    pollStop();
+  }
   if (depth == 0) {
-    const int score = static_cast<int>(color) * evaluator.evaluate(board);
+    const int score =
+        static_cast<int>(color) *
+        (legal_moves_bb == kUnknownMoves
+             ? evaluator.evaluate(board, accumulator)
+             : evaluator.evaluateWithMoves(board, accumulator, color,
+                                           legal_moves_bb));
     return {score, -1}; // Return score and no move index
   }
-  uint64_t legal_moves_bb = getPossibleMoves(board, color);
+  // The parent passes our moves down when its move ordering generated them
+  if (legal_moves_bb == kUnknownMoves) {
+    legal_moves_bb = getPossibleMoves(board, color);
+  }
   if (legal_moves_bb == 0) {
-    if (othello::getPossibleMoves(board, opponent(color)) == 0) {
+    // Passes are only detected here, where they cost nothing extra: the
+    // opponent's moves are needed to tell a pass from the end of the game,
+    // and the passed position reuses them.
+    const uint64_t opponent_moves = getPossibleMoves(board, opponent(color));
+    if (opponent_moves == 0) {
       // No legal moves for both players, game over. Evaluate based on disc
       // count.
       const auto disc_count = countDiscs(board);
@@ -198,37 +1117,57 @@ Engine::negamax(const GameBoard &board,
                         (disc_count.first - disc_count.second);
       return {score, -1}; // Return score and no move index
     }
-    // pass turn
-    const std::pair<int, int> pair = negamax(
-        board, transposition_table, depth - 1, -beta, -alpha, opponent(color));
+    // pass turn; the passed position hashes with the opponent to move
+    const std::pair<int, int> pair =
+        negamax(passTurn(board), accumulator, depth - 1, -beta, -alpha,
+                opponent(color), ctx, ply + 1, split, opponent_moves);
     return {-pair.first, -1}; // Negate the opponent's score
   }
 
-  std::vector<int> legal_moves = order_moves(legal_moves_bb, transposition_table, board.zobrist_hash);
+  MoveList legal_moves;
+  const bool use_killers = use_history && ply < SearchContext::kMaxPly;
+  scoreMoves(board, legal_moves_bb, color, hash_move,
+             depth >= kMobilityOrderingDepth,
+             use_killers ? &ctx.killers[ply] : nullptr,
+             use_history ? &ctx.history[colorIndex(color)] : nullptr,
+             legal_moves);
 
-  std::pair<int, int8_t> best_pair = {
-      -INF, legal_moves[0]}; // initialize with worst case
-  bool first = true;
-  for (const int move : legal_moves) {
-    const GameBoard new_board = applyMove(board, move, color);
+  std::pair<int, int8_t> best_pair = {-INF, -1}; // initialize with worst case
+  for (size_t i = 0; i < legal_moves.size(); ++i) {
+    if (i == 1 && depth >= kMinSplitDepth && legal_moves.size() > 2 &&
+        search_mode == SearchMode::YBWC) {
+      // Young Brothers Wait: the eldest brother has been searched serially
+      // and did not cut off, so the remaining moves are searched in parallel.
+      legal_moves.sortFrom(i);
+      searchSplitPoint(board, accumulator, legal_moves, depth, ply, alpha,
+                       beta, color, split, best_pair);
+      break;
+    }
+    const int move = legal_moves.pickNext(i);
+    const uint64_t replies = legal_moves.replies(move);
+    uint64_t flips;
+    const GameBoard new_board = playMove(board, legal_moves, move, color, flips);
+    transposition_table.prefetch(new_board.zobrist_hash);
+    EvalAccumulator child_accumulator;
+    advance(accumulator, move, flips, color, child_accumulator);
 
     int score;
-    if (first) {
+    if (i == 0) {
       // First move: full window to seed alpha
-      auto r = negamax(new_board, transposition_table, depth - 1, -beta, -alpha,
-                       opponent(color));
+      auto r = negamax(new_board, child_accumulator, depth - 1, -beta, -alpha,
+                       opponent(color), ctx, ply + 1, split, replies);
       score = -r.first;
-      first = false;
     } else {
       // PVS: scout (zero-window) first
-      auto pr = negamax(new_board, transposition_table, depth - 1, -alpha - 1,
-                        -alpha, opponent(color));
+      auto pr = negamax(new_board, child_accumulator, depth - 1, -alpha - 1,
+                        -alpha, opponent(color), ctx, ply + 1, split, replies);
       int probe = -pr.first;
 
       if (probe > alpha) {
         // Fail-high -> re-search with full window
-        auto fr = negamax(new_board, transposition_table, depth - 1, -beta,
-                          -alpha, opponent(color));
+        auto fr = negamax(new_board, child_accumulator, depth - 1, -beta,
+                          -alpha, opponent(color), ctx, ply + 1, split,
+                          replies);
         score = -fr.first;
       } else {
         // Fail-low -> accept scout
@@ -240,8 +1179,21 @@ Engine::negamax(const GameBoard &board,
       best_pair = {score, move};
     }
     alpha = std::max(alpha, score);
-    if (alpha >= beta)
+    if (alpha >= beta) {
+      cutoffs.fetch_add(1, std::memory_order_relaxed);
+      if (i == 0) {
+        firstMoveCutoffs.fetch_add(1, std::memory_order_relaxed);
+      }
+      if (use_history) {
+        ctx.recordCutoff(ply, color, move, depth);
+      }
       break; // cutoff
+    }
+  }
+
+  // Results below an aborted split point are incomplete; don't cache them.
+  if (split != nullptr && split->aborted()) {
+    return {0, -1};
   }
 
   BoundType bound_type;
@@ -251,8 +1203,96 @@ Engine::negamax(const GameBoard &board,
     bound_type = BoundType::LOWER;
   else
     bound_type = BoundType::EXACT;
-  transposition_table[board.zobrist_hash] =
-      TTEntry{best_pair.first, depth, bound_type, best_pair.second};
+  const int8_t stored_move =
+      key.symmetry != 0 && best_pair.second >= 0
+          ? static_cast<int8_t>(transformSquare(best_pair.second, key.symmetry))
+          : best_pair.second;
+  transposition_table.store(key.key, best_pair.first, depth, bound_type,
+                            stored_move);
   return best_pair;
 }
+
+void Engine::searchSplitPoint(const GameBoard &board,
+                              const EvalAccumulator &accumulator,
+                              const MoveList &moves,
+                              uint8_t depth, int ply, int &alpha, int beta,
+                              Color color, const SplitPoint *parent,
+                              std::pair<int, int8_t> &best_pair) {
+  SplitPoint sp{parent, {alpha}, beta, {false}, {1}};
+  const size_t move_count = moves.size();
+
+  std::array<std::pair<int, int8_t>, 64> results;
+  for (size_t i = 1; i < move_count; ++i) {
+    results[i] = {-INF, -1};
+  }
+
+  // Every participating thread claims the next unsearched move, so moves are
+  // started in order no matter which thread picks them up.
+  auto search_brothers = [&]() {
+    SearchContext &ctx = threadContext();
+    while (!sp.aborted()) {
+      const size_t i = sp.next_move.fetch_add(1, std::memory_order_relaxed);
+      if (i >= move_count) {
+        return;
+      }
+      const int a = sp.alpha.load(std::memory_order_relaxed);
+      if (a >= sp.beta) {
+        return;
+      }
+      const int move = moves[i].square;
+      const uint64_t replies = moves.replies(move);
+      uint64_t flips;
+      const GameBoard child = playMove(board, moves, move, color, flips);
+      transposition_table.prefetch(child.zobrist_hash);
+      EvalAccumulator child_accumulator;
+      advance(accumulator, move, flips, color, child_accumulator);
+
+      // Scout search (zero window) against the shared alpha
+      int score = -negamax(child, child_accumulator, depth - 1, -a - 1, -a,
+                           opponent(color), ctx, ply + 1, &sp, replies)
+                       .first;
+      if (score > a && score < sp.beta && !sp.aborted()) {
+        // Re-search with full window
+        score = -negamax(child, child_accumulator, depth - 1, -sp.beta, -a,
+                         opponent(color), ctx, ply + 1, &sp, replies)
+                     .first;
+      }
+      if (sp.aborted()) {
+        return;
+      }
+      results[i] = {score, static_cast<int8_t>(move)};
+
+      // Raise shared alpha; a fail-high refutes the whole split point
+      int cur = sp.alpha.load(std::memory_order_relaxed);
+      while (score > cur && !sp.alpha.compare_exchange_weak(cur, score)) {
+      }
+      if (score >= sp.beta) {
+        sp.cutoff.store(true, std::memory_order_relaxed);
+        cutoffs.fetch_add(1, std::memory_order_relaxed);
+        if (use_history) {
+          ctx.recordCutoff(ply, color, move, depth);
+        }
+      }
+    }
+  };
+
+  // Offer helper tasks to idle workers, then work on the brothers ourselves.
+  // Tasks live on this frame until the group has been waited on.
+  std::array<utils::Task, 64> helpers;
+  const size_t helper_count = std::min(move_count - 2, thread_pool.size());
+  utils::TaskGroup group;
+  for (size_t h = 0; h < helper_count; ++h) {
+    helpers[h].emplace([&search_brothers] { search_brothers(); });
+    thread_pool.spawn(group, helpers[h]);
+  }
+  search_brothers();
+  thread_pool.wait(group);
+
+  for (size_t i = 1; i < move_count; ++i) {
+    if (results[i].first > best_pair.first) {
+      best_pair = results[i];
+    }
+  }
+  alpha = std::max(alpha, best_pair.first);
+}
 } // namespace othello
@@ -0,0 +1,106 @@
+// Copyright (c) 2026 Alex Li
+// EnginePool.cpp
+// Implementation of the engine pool and its admission queue
+
+#include "othello/EnginePool.hpp"
+
+#include <algorithm>
+#include <mutex>
+
+namespace othello {
+
+EnginePool::Lease::~Lease() {
+  if (pool != nullptr) {
+    pool->release(engine);
+  }
+}
+
+EnginePool::EnginePool(const Evaluator &evaluator,
+                       utils::ThreadPool &thread_pool,
+                       const EnginePoolOptions &options)
+    : max_queue(options.max_queue) {
+  const size_t count = std::max<size_t>(1, options.engines);
+  // Concurrent Lazy SMP searches split the workers instead of each taking
+  // all of them
+  const size_t helper_threads = std::max<size_t>(1, thread_pool.size() / count);
+  engines.reserve(count);
+  idle.reserve(count);
+  for (size_t i = 0; i < count; ++i) {
+    engines.push_back(
+        std::make_unique<Engine>(evaluator, thread_pool, options.tt_size_mb));
+    engines.back()->setVerbose(false);
+    engines.back()->setSearchMode(options.search_mode);
+    engines.back()->setHelperThreads(helper_threads);
+    engines.back()->setSearchDriver(options.search_driver);
+    engines.back()->setEndgameEmpties(options.endgame_empties);
+    engines.back()->setOpeningBook(options.opening_book);
+    idle.push_back(engines.back().get());
+  }
+}
+
+std::optional<EnginePool::Lease>
+EnginePool::acquire(std::chrono::steady_clock::time_point deadline,
+                    const StopCondition &stop) {
+  std::unique_lock<std::mutex> lock(mutex);
+  const uint64_t queued = next_ticket - now_serving - abandoned.size();
+  const bool must_wait = idle.empty() || queued != 0;
+  if (must_wait && queued >= max_queue) {
+    return std::nullopt; // queue full: shed load instead of piling up
+  }
+
+  // FIFO admission: wait until it is this request's turn and an engine is free
+  const uint64_t ticket = next_ticket++;
+  while (ticket != now_serving || idle.empty()) {
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= deadline || (stop && stop())) {
+      // Give up the ticket; whoever reaches it next skips it
+      if (ticket == now_serving) {
+        advanceServing();
+      } else {
+        abandoned.insert(ticket);
+      }
+      lock.unlock();
+      engine_released.notify_all();
+      return std::nullopt;
+    }
+    // Without a stop condition only the deadline needs a wakeup
+    engine_released.wait_until(
+        lock, stop && deadline - now > kStopPollInterval
+                  ? now + kStopPollInterval
+                  : deadline);
+  }
+  advanceServing();
+  Engine *engine = idle.back();
+  idle.pop_back();
+  lock.unlock();
+  // The next ticket holder may be able to proceed too
+  engine_released.notify_all();
+  return Lease(this, engine);
+}
+
+void EnginePool::advanceServing() {
+  ++now_serving;
+  while (abandoned.erase(now_serving) != 0) {
+    ++now_serving;
+  }
+}
+
+void EnginePool::release(Engine *engine) {
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    idle.push_back(engine);
+  }
+  engine_released.notify_all();
+}
+
+size_t EnginePool::activeSearches() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return engines.size() - idle.size();
+}
+
+size_t EnginePool::queuedRequests() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  return static_cast<size_t>(next_ticket - now_serving - abandoned.size());
+}
+
+} // namespace othello
@@ -4,13 +4,16 @@
 
 #include "othello/GameBoard.hpp"
 
-#include <chrono>  // For time-based seeding
-#include <random>  // For random number generation
 #include <bit>
 
 #include "othello/OthelloRules.hpp"  // For isValidMove
 
 namespace {
+/// The keys of the default seed, generated at compile time
+constexpr othello::ZobristKeys kDefaultKeys =
+    othello::makeZobristKeys(othello::kDefaultZobristSeed);
+
+#ifndef OTHELLO_MIX_HASH
 /// @brief Update the zobrist hash for a move
 /// @param hash (uint64_t) : The current Zobrist hash
 /// @param position (int) : The position of the move
@@ -34,71 +37,54 @@ uint64_t updateZobristHash(uint64_t hash, int position, uint64_t flip_bb,
   }
   return hash;
 }
+#endif
 }  // namespace
 
 namespace othello {
 
-ZobristTable zobrist_table;
-uint64_t zobrist_black_turn;
+constinit ZobristTable zobrist_table = kDefaultKeys.squares;
+constinit uint64_t zobrist_black_turn = kDefaultKeys.black_turn;
 
 GameBoard applyMove(const GameBoard &b, int position, Color color) {
+  uint64_t flips;
+  return applyMove(b, position, color, flips);
+}
+
+GameBoard applyMove(const GameBoard &b, int position, Color color,
+                    uint64_t &flips) {
   uint64_t my_board = color == Color::BLACK ? b.black_bb : b.white_bb;
   uint64_t op_board = color == Color::BLACK ? b.white_bb : b.black_bb;
-  uint64_t empty = ~(my_board | op_board);
-  uint64_t pos_board = 1ULL << position;
-
-  uint64_t flips = getDirectionalFlips(pos_board, my_board, op_board, empty, -1,
-                                       othello::LEFT_EDGE_MASK);  // West
-
-  flips |= getDirectionalFlips(pos_board, my_board, op_board, empty, 1,
-                               othello::RIGHT_EDGE_MASK);  // East
-
-  flips |= getDirectionalFlips(pos_board, my_board, op_board, empty, 8,
-                               othello::BOTTOM_EDGE_MASK);  // South
-
-  flips |= getDirectionalFlips(pos_board, my_board, op_board, empty, -8,
-                               othello::TOP_EDGE_MASK);  // North
-
-  flips |= getDirectionalFlips(
-      pos_board, my_board, op_board, empty, -7,
-      othello::TOP_EDGE_MASK & othello::RIGHT_EDGE_MASK);  // North-East
-
-  flips |= getDirectionalFlips(
-      pos_board, my_board, op_board, empty, -9,
-      othello::TOP_EDGE_MASK & othello::LEFT_EDGE_MASK);  // North-West
-
-  flips |= getDirectionalFlips(
-      pos_board, my_board, op_board, empty, 7,
-      othello::BOTTOM_EDGE_MASK & othello::LEFT_EDGE_MASK);  // South-West
-
-  flips |= getDirectionalFlips(
-      pos_board, my_board, op_board, empty, 9,
-      othello::BOTTOM_EDGE_MASK & othello::RIGHT_EDGE_MASK);  // South-East
+  flips = getFlips(my_board, op_board, position);
+  const GameBoard next = makeMove(b, position, color, flips);
+  // Switch turn only if opponent has moves
+  if (getPossibleMoves(next, opponent(color)) == 0) {
+    return passTurn(next);
+  }
+  return next;
+}
 
-  my_board = my_board | pos_board | flips;
+GameBoard makeMove(const GameBoard &b, int position, Color color,
+                   uint64_t flips) {
+  uint64_t my_board = color == Color::BLACK ? b.black_bb : b.white_bb;
+  uint64_t op_board = color == Color::BLACK ? b.white_bb : b.black_bb;
+  my_board |= (1ULL << position) | flips;
   op_board ^= flips;
-  uint64_t new_hash = updateZobristHash(b.zobrist_hash, position, flips, color);
-  uint64_t new_black = color == Color::BLACK ? my_board : op_board;
-  uint64_t new_white = color == Color::BLACK ? op_board : my_board;
-  Color next_player = color;
-  if (getPossibleMoves(GameBoard(new_black, new_white, 0, color),
-                       opponent(color)) != 0) {
-    next_player = opponent(color);
-    new_hash ^= zobrist_black_turn;  // Switch turn only if opponent has moves
-  }
-  return GameBoard(new_black, new_white, new_hash, next_player);
+  const uint64_t new_black = color == Color::BLACK ? my_board : op_board;
+  const uint64_t new_white = color == Color::BLACK ? op_board : my_board;
+#ifdef OTHELLO_MIX_HASH
+  const uint64_t new_hash = zobristHash(new_black, new_white, opponent(color));
+#else
+  const uint64_t new_hash =
+      updateZobristHash(b.zobrist_hash, position, flips, color) ^
+      zobrist_black_turn;
+#endif
+  return GameBoard(new_black, new_white, new_hash, opponent(color));
 }
 
-void initializeZobrist() {
-  std::mt19937_64 rng(
-      std::chrono::system_clock::now().time_since_epoch().count());
-  std::uniform_int_distribution<uint64_t> dist;
-  for (int i = 0; i < 64; ++i) {
-    for (int j = 0; j < 2; ++j) {
-      zobrist_table[i][j] = dist(rng);
-    }
-  }
-  zobrist_black_turn = dist(rng);
+void initializeZobrist(uint64_t seed) {
+  const ZobristKeys keys = makeZobristKeys(seed);
+  zobrist_table = keys.squares;
+  zobrist_black_turn = keys.black_turn;
 }
 
 /// @brief Generate a Zobrist hash for the game board
@@ -107,6 +93,10 @@ void initializeZobrist() {
 /// @param turn (Color) : The color of the player to move
 /// @return uint64_t : The Zobrist hash for the board state
 uint64_t zobristHash(uint64_t black_bb, uint64_t white_bb, Color turn) {
+#ifdef OTHELLO_MIX_HASH
+  return mixBitboards(black_bb, white_bb) ^
+         (turn == Color::BLACK ? zobrist_black_turn : 0);
+#else
   uint64_t hash = 0;
   while (black_bb) {
     int pos = std::countr_zero(
@@ -124,6 +114,7 @@ uint64_t zobristHash(uint64_t black_bb, uint64_t white_bb, Color turn) {
     hash ^= zobrist_black_turn;  // Add turn information
   }
   return hash;
+#endif
 }
 
 }  // namespace othello
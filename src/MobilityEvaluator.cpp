@@ -8,8 +8,20 @@
 #include "othello/GameBoard.hpp"
 #include "othello/OthelloRules.hpp"
 #include "othello/evaluator/Evaluator.hpp"
+#include "othello/evaluator/SquareWeights.hpp"
 
 namespace othello {
+namespace {
+// The region and disc weights evaluate() applies, as one table
+constexpr SquareWeights kWeights =
+    makeSquareWeights(1000, -300, -50, 10, 2, 3, 2);
+
+int mobilityScore(const GameBoard &board) {
+  return 10 * (std::popcount(getPossibleMoves(board, Color::BLACK)) -
+               std::popcount(getPossibleMoves(board, Color::WHITE)));
+}
+} // namespace
+
 int MobilityEvaluator::evaluate(const GameBoard &board) const {
   int score = 0;
 
@@ -42,5 +54,29 @@ int MobilityEvaluator::evaluate(const GameBoard &board) const {
 
   return score;
 }
+
+void MobilityEvaluator::reset(const GameBoard &board,
+                              EvalAccumulator &accumulator) const {
+  accumulator.score = squareScore(kWeights, board);
+}
+
+void MobilityEvaluator::update(EvalAccumulator &accumulator, int move,
+                               uint64_t flips, Color color) const {
+  accumulator.score += squareScoreDelta(kWeights, move, flips, color);
+}
+
+int MobilityEvaluator::evaluate(const GameBoard &board,
+                                const EvalAccumulator &accumulator) const {
+  return accumulator.score + mobilityScore(board);
+}
+
+int MobilityEvaluator::evaluateWithMoves(const GameBoard &board,
+                                         const EvalAccumulator &accumulator,
+                                         Color color, uint64_t moves) const {
+  const int mobility =
+      std::popcount(moves) -
+      std::popcount(getPossibleMoves(board, opponent(color)));
+  return accumulator.score + 10 * static_cast<int>(color) * mobility;
+}
 }  // namespace othello
 
@@ -0,0 +1,367 @@
+// Copyright (c) 2026 Alex Li
+// MoveGen.cpp
+// Scalar and SIMD move generation kernels and their runtime dispatch
+
+#include "othello/MoveGen.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdlib>
+
+#include "othello/Constants.hpp"
+#include "othello/OthelloRules.hpp"
+
+#if defined(__x86_64__) && (defined(__GNUC__) || defined(__clang__))
+#define OTHELLO_X86_SIMD 1
+#include <immintrin.h>
+#endif
+
+namespace othello {
+namespace {
+
+uint64_t scalarMoves(uint64_t my_board, uint64_t op_board) {
+  uint64_t empty = ~(my_board | op_board);
+
+  uint64_t moves = getDirectionalMoves(my_board, op_board, empty, -1,
+                                       othello::LEFT_EDGE_MASK); // West
+  moves |= getDirectionalMoves(my_board, op_board, empty, 1,
+                               othello::RIGHT_EDGE_MASK); // East
+  moves |= getDirectionalMoves(my_board, op_board, empty, 8,
+                               othello::BOTTOM_EDGE_MASK); // South
+  moves |= getDirectionalMoves(my_board, op_board, empty, -8,
+                               othello::TOP_EDGE_MASK); // North
+  moves |= getDirectionalMoves(my_board, op_board, empty, -7,
+                               othello::TOP_EDGE_MASK &
+                                   othello::RIGHT_EDGE_MASK); // North-East
+  moves |= getDirectionalMoves(my_board, op_board, empty, -9,
+                               othello::TOP_EDGE_MASK &
+                                   othello::LEFT_EDGE_MASK); // North-West
+  moves |= getDirectionalMoves(my_board, op_board, empty, 7,
+                               othello::BOTTOM_EDGE_MASK &
+                                   othello::LEFT_EDGE_MASK); // South-West
+  moves |= getDirectionalMoves(my_board, op_board, empty, 9,
+                               othello::BOTTOM_EDGE_MASK &
+                                   othello::RIGHT_EDGE_MASK); // South-East
+  return moves;
+}
+
+/// @brief The squares of every line through a square, going away from it
+/// @details up[] holds the four directions towards higher squares (east,
+///          south-west, south, south-east) and down[] the four towards
+///          lower squares, each stopping at the edge of the board.
+struct SquareRays {
+  uint64_t up[4];
+  uint64_t down[4];
+};
+
+consteval std::array<SquareRays, 64> makeSquareRays() {
+  constexpr int kDeltas[4][2] = {{0, 1}, {1, -1}, {1, 0}, {1, 1}};
+  std::array<SquareRays, 64> rays{};
+  for (int square = 0; square < 64; ++square) {
+    for (int d = 0; d < 4; ++d) {
+      for (int sign : {1, -1}) {
+        uint64_t ray = 0;
+        int row = square / 8 + sign * kDeltas[d][0];
+        int col = square % 8 + sign * kDeltas[d][1];
+        for (; row >= 0 && row < 8 && col >= 0 && col < 8;
+             row += sign * kDeltas[d][0], col += sign * kDeltas[d][1]) {
+          ray |= 1ULL << (row * 8 + col);
+        }
+        (sign > 0 ? rays[square].up : rays[square].down)[d] = ray;
+      }
+    }
+  }
+  return rays;
+}
+
+constexpr std::array<SquareRays, 64> kSquareRays = makeSquareRays();
+
+/// @brief Flips along a ray towards higher squares
+/// @details The first square on the ray that isn't an opponent disc is the
+///          outflanking square; if it holds one of our discs, every ray
+///          square below it flips. Subtracting one from the outflank bit
+///          gives those squares with no loop over the run.
+inline uint64_t flipsUp(uint64_t ray, uint64_t my_board, uint64_t op_board) {
+  const uint64_t blockers = ray & ~op_board;
+  const uint64_t outflank = blockers & (0 - blockers) & my_board;
+  return (outflank - (outflank != 0)) & ray;
+}
+
+/// @brief Flips along a ray towards lower squares
+/// @details As flipsUp, with the outflanking square the highest non-opponent
+///          square on the ray. The bit 0 sentinel keeps countl_zero defined
+///          and can only outflank when square 0 is on the ray, in which case
+///          it is an opponent disc.
+inline uint64_t flipsDown(uint64_t ray, uint64_t my_board, uint64_t op_board) {
+  const uint64_t blockers = (ray & ~op_board) | 1;
+  const uint64_t outflank =
+      (0x8000000000000000ULL >> std::countl_zero(blockers)) & my_board & ray;
+  return (0 - (outflank << 1)) & ray;
+}
+
+/// @brief Branchless flips, in constant time whatever the run lengths
+uint64_t scalarFlips(uint64_t my_board, uint64_t op_board, int position) {
+  const SquareRays &rays = kSquareRays[position];
+  uint64_t flips = 0;
+  for (int d = 0; d < 4; ++d) {
+    flips |= flipsUp(rays.up[d], my_board, op_board);
+    flips |= flipsDown(rays.down[d], my_board, op_board);
+  }
+  return flips;
+}
+
+constexpr MoveGenKernels kScalarKernels{SimdLevel::SCALAR, scalarMoves,
+                                        scalarFlips};
+
+#ifdef OTHELLO_X86_SIMD
+
+// The SIMD kernels run the four line directions (1 = east-west, 8 =
+// north-south, 9 and 7 = the diagonals) side by side in 64-bit lanes.
+// Opponent discs on the a and h files are masked out for every direction
+// except north-south, so no run can wrap around an edge. Runs of up to six
+// discs are found Kogge-Stone style: two single steps, then two steps of
+// twice the distance through pairs of adjacent opponent discs.
+constexpr uint64_t kInnerFiles = 0x7E7E7E7E7E7E7E7EULL;
+
+// ---- AVX2: one 256-bit chain per shift direction ----
+
+__attribute__((target("avx2"))) inline __m256i avx2Or(__m256i a, __m256i b,
+                                                       __m256i c) {
+  return _mm256_or_si256(a, _mm256_and_si256(b, c)); // a | (b & c)
+}
+
+/// @brief Extend runs of opponent discs from the discs in from, in every
+///        lane's direction, for both shift directions
+/// @param left Receives the runs going towards higher squares
+/// @param right Receives the runs going towards lower squares
+__attribute__((target("avx2"))) inline void
+avx2Runs(__m256i from, __m256i inner, __m256i shift, __m256i &left,
+         __m256i &right) {
+  const __m256i shift2 = _mm256_add_epi64(shift, shift);
+  // Pairs of adjacent opponent discs, indexed by the far disc each way
+  const __m256i pairs_left = _mm256_and_si256(inner, _mm256_sllv_epi64(inner, shift));
+  const __m256i pairs_right = _mm256_srlv_epi64(pairs_left, shift);
+
+  left = _mm256_and_si256(inner, _mm256_sllv_epi64(from, shift));
+  right = _mm256_and_si256(inner, _mm256_srlv_epi64(from, shift));
+  left = avx2Or(left, inner, _mm256_sllv_epi64(left, shift));
+  right = avx2Or(right, inner, _mm256_srlv_epi64(right, shift));
+  left = avx2Or(left, pairs_left, _mm256_sllv_epi64(left, shift2));
+  right = avx2Or(right, pairs_right, _mm256_srlv_epi64(right, shift2));
+  left = avx2Or(left, pairs_left, _mm256_sllv_epi64(left, shift2));
+  right = avx2Or(right, pairs_right, _mm256_srlv_epi64(right, shift2));
+}
+
+__attribute__((target("avx2"))) inline uint64_t avx2ReduceOr(__m256i v) {
+  __m128i x = _mm_or_si128(_mm256_castsi256_si128(v),
+                           _mm256_extracti128_si256(v, 1));
+  x = _mm_or_si128(x, _mm_unpackhi_epi64(x, x));
+  return static_cast<uint64_t>(_mm_cvtsi128_si64(x));
+}
+
+__attribute__((target("avx2"))) inline __m256i avx2Inner(uint64_t op_board) {
+  return _mm256_and_si256(
+      _mm256_set1_epi64x(static_cast<long long>(op_board)),
+      _mm256_set_epi64x(static_cast<long long>(kInnerFiles),
+                        static_cast<long long>(kInnerFiles), -1,
+                        static_cast<long long>(kInnerFiles)));
+}
+
+__attribute__((target("avx2"))) uint64_t avx2Moves(uint64_t my_board,
+                                                   uint64_t op_board) {
+  const __m256i shift = _mm256_set_epi64x(7, 9, 8, 1);
+  __m256i left, right;
+  avx2Runs(_mm256_set1_epi64x(static_cast<long long>(my_board)),
+           avx2Inner(op_board), shift, left, right);
+  const __m256i moves = _mm256_or_si256(_mm256_sllv_epi64(left, shift),
+                                        _mm256_srlv_epi64(right, shift));
+  return avx2ReduceOr(moves) & ~(my_board | op_board);
+}
+
+__attribute__((target("avx2"))) uint64_t avx2Flips(uint64_t my_board,
+                                                   uint64_t op_board,
+                                                   int position) {
+  const __m256i shift = _mm256_set_epi64x(7, 9, 8, 1);
+  const __m256i mine = _mm256_set1_epi64x(static_cast<long long>(my_board));
+  __m256i left, right;
+  avx2Runs(_mm256_set1_epi64x(static_cast<long long>(1ULL << position)),
+           avx2Inner(op_board), shift, left, right);
+  // A run only flips if one of our discs closes it
+  const __m256i zero = _mm256_setzero_si256();
+  const __m256i open_left = _mm256_cmpeq_epi64(
+      _mm256_and_si256(_mm256_sllv_epi64(left, shift), mine), zero);
+  const __m256i open_right = _mm256_cmpeq_epi64(
+      _mm256_and_si256(_mm256_srlv_epi64(right, shift), mine), zero);
+  return avx2ReduceOr(_mm256_or_si256(_mm256_andnot_si256(open_left, left),
+                                      _mm256_andnot_si256(open_right, right)));
+}
+
+// ---- AVX-512: all eight directions in one 512-bit chain ----
+
+// GCC 12's unmasked AVX-512 intrinsics pass _mm512_undefined_*() as the
+// merge source, which trips -Wuninitialized once inlined
+#pragma GCC diagnostic push
+#pragma GCC diagnostic ignored "-Wuninitialized"
+
+/// Lanes 4-7 shift towards lower squares
+constexpr __mmask8 kRightLanes = 0xF0;
+
+/// @brief Shift lanes 0-3 left and lanes 4-7 right by their counts
+__attribute__((target("avx512f"))) inline __m512i avx512Shift(__m512i x,
+                                                              __m512i count) {
+  return _mm512_mask_srlv_epi64(_mm512_sllv_epi64(x, count), kRightLanes, x,
+                                count);
+}
+
+/// @brief OR the eight lanes together
+__attribute__((target("avx512f"))) inline uint64_t avx512ReduceOr(__m512i x) {
+  return avx2ReduceOr(_mm256_or_si256(_mm512_castsi512_si256(x),
+                                      _mm512_extracti64x4_epi64(x, 1)));
+}
+
+/// @brief a | (b & c)
+__attribute__((target("avx512f"))) inline __m512i avx512Or(__m512i a,
+                                                           __m512i b,
+                                                           __m512i c) {
+  return _mm512_ternarylogic_epi64(a, b, c, 0xF8);
+}
+
+__attribute__((target("avx512f"))) inline __m512i avx512Runs(__m512i from,
+                                                             uint64_t op_board,
+                                                             __m512i shift) {
+  const long long inner_files = static_cast<long long>(kInnerFiles);
+  const __m512i inner = _mm512_and_si512(
+      _mm512_set1_epi64(static_cast<long long>(op_board)),
+      _mm512_set_epi64(inner_files, inner_files, -1, inner_files, inner_files,
+                       inner_files, -1, inner_files));
+  const __m512i shift2 = _mm512_add_epi64(shift, shift);
+  const __m512i pairs = _mm512_and_si512(inner, avx512Shift(inner, shift));
+
+  __m512i run = _mm512_and_si512(inner, avx512Shift(from, shift));
+  run = avx512Or(run, inner, avx512Shift(run, shift));
+  run = avx512Or(run, pairs, avx512Shift(run, shift2));
+  return avx512Or(run, pairs, avx512Shift(run, shift2));
+}
+
+__attribute__((target("avx512f"))) uint64_t avx512Moves(uint64_t my_board,
+                                                        uint64_t op_board) {
+  const __m512i shift = _mm512_set_epi64(7, 9, 8, 1, 7, 9, 8, 1);
+  const __m512i run = avx512Runs(
+      _mm512_set1_epi64(static_cast<long long>(my_board)), op_board, shift);
+  return avx512ReduceOr(avx512Shift(run, shift)) & ~(my_board | op_board);
+}
+
+__attribute__((target("avx512f"))) uint64_t avx512Flips(uint64_t my_board,
+                                                        uint64_t op_board,
+                                                        int position) {
+  const __m512i shift = _mm512_set_epi64(7, 9, 8, 1, 7, 9, 8, 1);
+  const __m512i run = avx512Runs(
+      _mm512_set1_epi64(static_cast<long long>(1ULL << position)), op_board,
+      shift);
+  // A run only flips if one of our discs closes it
+  const __mmask8 closed =
+      _mm512_test_epi64_mask(avx512Shift(run, shift),
+                             _mm512_set1_epi64(static_cast<long long>(my_board)));
+  return avx512ReduceOr(_mm512_maskz_mov_epi64(closed, run));
+}
+
+#pragma GCC diagnostic pop
+
+constexpr MoveGenKernels kAvx2Kernels{SimdLevel::AVX2, avx2Moves, avx2Flips};
+constexpr MoveGenKernels kAvx512Kernels{SimdLevel::AVX512, avx512Moves,
+                                        avx512Flips};
+
+#endif // OTHELLO_X86_SIMD
+
+/// @brief The best supported level, capped by OTHELLO_SIMD if set
+SimdLevel startupLevel() {
+  SimdLevel level = detectSimdLevel();
+  if (const char *name = std::getenv("OTHELLO_SIMD")) {
+    if (const auto cap = parseSimdLevel(name); cap && *cap < level) {
+      level = *cap;
+    }
+  }
+  return level;
+}
+
+} // namespace
+
+constinit const MoveGenKernels *active_move_gen = &kScalarKernels;
+
+// Pick the kernels before main(); until then (e.g. from other static
+// initializers) the scalar kernels are used.
+[[maybe_unused]] static const bool kStartupSelected =
+    selectMoveGen(startupLevel());
+
+uint64_t referenceFlips(uint64_t my_board, uint64_t op_board, int position) {
+  uint64_t empty = ~(my_board | op_board);
+  uint64_t pos_board = 1ULL << position;
+
+  uint64_t flips = getDirectionalFlips(pos_board, my_board, op_board, empty, -1,
+                                       othello::LEFT_EDGE_MASK);  // West
+  flips |= getDirectionalFlips(pos_board, my_board, op_board, empty, 1,
+                               othello::RIGHT_EDGE_MASK);  // East
+  flips |= getDirectionalFlips(pos_board, my_board, op_board, empty, 8,
+                               othello::BOTTOM_EDGE_MASK);  // South
+  flips |= getDirectionalFlips(pos_board, my_board, op_board, empty, -8,
+                               othello::TOP_EDGE_MASK);  // North
+  flips |= getDirectionalFlips(
+      pos_board, my_board, op_board, empty, -7,
+      othello::TOP_EDGE_MASK & othello::RIGHT_EDGE_MASK);  // North-East
+  flips |= getDirectionalFlips(
+      pos_board, my_board, op_board, empty, -9,
+      othello::TOP_EDGE_MASK & othello::LEFT_EDGE_MASK);  // North-West
+  flips |= getDirectionalFlips(
+      pos_board, my_board, op_board, empty, 7,
+      othello::BOTTOM_EDGE_MASK & othello::LEFT_EDGE_MASK);  // South-West
+  flips |= getDirectionalFlips(
+      pos_board, my_board, op_board, empty, 9,
+      othello::BOTTOM_EDGE_MASK & othello::RIGHT_EDGE_MASK);  // South-East
+  return flips;
+}
+
+SimdLevel detectSimdLevel() {
+#ifdef OTHELLO_X86_SIMD
+  // __builtin_cpu_supports also checks that the OS saves the wide registers
+  if (__builtin_cpu_supports("avx512f")) {
+    return SimdLevel::AVX512;
+  }
+  if (__builtin_cpu_supports("avx2")) {
+    return SimdLevel::AVX2;
+  }
+#endif
+  return SimdLevel::SCALAR;
+}
+
+const MoveGenKernels *moveGenKernels(SimdLevel level) {
+  if (level > detectSimdLevel()) {
+    return nullptr;
+  }
+  switch (level) {
+#ifdef OTHELLO_X86_SIMD
+  case SimdLevel::AVX512:
+    return &kAvx512Kernels;
+  case SimdLevel::AVX2:
+    return &kAvx2Kernels;
+#endif
+  case SimdLevel::SCALAR:
+    return &kScalarKernels;
+  default:
+    return nullptr;
+  }
+}
+
+bool selectMoveGen(SimdLevel level) {
+  const MoveGenKernels *kernels = moveGenKernels(level);
+  if (kernels == nullptr) {
+    return false;
+  }
+  active_move_gen = kernels;
+  return true;
+}
+
+void installMoveGen(const MoveGenKernels &kernels) {
+  active_move_gen = &kernels;
+}
+
+} // namespace othello
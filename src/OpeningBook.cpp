@@ -0,0 +1,143 @@
+// Copyright (c) 2026 Alex Li
+// OpeningBook.cpp
+// Implementation of the memory-mapped opening book
+
+#include "othello/OpeningBook.hpp"
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include "othello/Hash.hpp"
+#include "othello/Symmetry.hpp"
+
+namespace othello {
+
+namespace {
+
+/// Header of a book file
+struct FileHeader {
+  char magic[4];
+  uint32_t version;
+  uint64_t entries;
+};
+
+static_assert(sizeof(FileHeader) == 16, "entries start 16-byte aligned");
+
+constexpr char kMagic[4] = {'O', 'T', 'B', 'K'};
+constexpr uint32_t kFileVersion = 1;
+
+/// Book files are little-endian; converts in either direction
+template <typename T> T fileOrder(T value) {
+  if constexpr (std::endian::native == std::endian::big) {
+    return std::byteswap(value);
+  }
+  return value;
+}
+
+} // namespace
+
+OpeningBook::OpeningBook(const std::string &path) {
+  const int fd = ::open(path.c_str(), O_RDONLY | O_CLOEXEC);
+  if (fd < 0) {
+    throw std::runtime_error("cannot open book file " + path);
+  }
+  struct stat status {};
+  if (::fstat(fd, &status) != 0 ||
+      static_cast<size_t>(status.st_size) < sizeof(FileHeader)) {
+    ::close(fd);
+    throw std::runtime_error(path + " is not an opening book");
+  }
+  mapping_size = static_cast<size_t>(status.st_size);
+  void *mapped = ::mmap(nullptr, mapping_size, PROT_READ, MAP_SHARED, fd, 0);
+  ::close(fd); // The mapping keeps the file alive
+  if (mapped == MAP_FAILED) {
+    throw std::runtime_error("cannot map book file " + path);
+  }
+  mapping = mapped;
+
+  FileHeader header;
+  std::memcpy(&header, mapping, sizeof(header));
+  const uint64_t count = fileOrder(header.entries);
+  if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+      fileOrder(header.version) != kFileVersion ||
+      count != (mapping_size - sizeof(FileHeader)) / sizeof(BookEntry) ||
+      (mapping_size - sizeof(FileHeader)) % sizeof(BookEntry) != 0) {
+    ::munmap(mapped, mapping_size);
+    throw std::runtime_error(path + " is not an opening book");
+  }
+  entries = reinterpret_cast<const BookEntry *>(
+      static_cast<const char *>(mapping) + sizeof(FileHeader));
+  entry_count = static_cast<size_t>(count);
+  // Lookups are binary searches; don't read ahead around every probe
+  ::madvise(mapped, mapping_size, MADV_RANDOM);
+}
+
+OpeningBook::~OpeningBook() {
+  ::munmap(const_cast<void *>(mapping), mapping_size);
+}
+
+OpeningBook::Canonical OpeningBook::canonical(uint64_t player,
+                                              uint64_t opponent) {
+  const CanonicalBoards boards = canonicalize(player, opponent);
+  return {mixBitboards(boards.first, boards.second), boards.symmetry};
+}
+
+std::optional<BookMove> OpeningBook::probe(const GameBoard &board,
+                                           Color color) const {
+  const uint64_t player =
+      color == Color::BLACK ? board.black_bb : board.white_bb;
+  const uint64_t opponent =
+      color == Color::BLACK ? board.white_bb : board.black_bb;
+  const Canonical position = canonical(player, opponent);
+
+  const BookEntry *end = entries + entry_count;
+  const BookEntry *found = std::lower_bound(
+      entries, end, position.key, [](const BookEntry &entry, uint64_t key) {
+        return fileOrder(entry.key) < key;
+      });
+  if (found == end || fileOrder(found->key) != position.key) {
+    return std::nullopt;
+  }
+  return BookMove{untransformSquare(found->move, position.symmetry),
+                  fileOrder(found->score), found->depth,
+                  fileOrder(found->visits)};
+}
+
+void OpeningBook::save(const std::string &path,
+                       std::vector<BookEntry> entries) {
+  std::sort(entries.begin(), entries.end(),
+            [](const BookEntry &a, const BookEntry &b) { return a.key < b.key; });
+  const auto duplicate = std::adjacent_find(
+      entries.begin(), entries.end(),
+      [](const BookEntry &a, const BookEntry &b) { return a.key == b.key; });
+  if (duplicate != entries.end()) {
+    throw std::runtime_error("book entries must have distinct keys");
+  }
+
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = fileOrder(kFileVersion);
+  header.entries = fileOrder(static_cast<uint64_t>(entries.size()));
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+  for (BookEntry &entry : entries) {
+    entry.key = fileOrder(entry.key);
+    entry.score = fileOrder(entry.score);
+    entry.visits = fileOrder(entry.visits);
+  }
+  out.write(reinterpret_cast<const char *>(entries.data()),
+            static_cast<std::streamsize>(entries.size() * sizeof(BookEntry)));
+  if (!out) {
+    throw std::runtime_error("cannot write book file " + path);
+  }
+}
+
+} // namespace othello
@@ -5,41 +5,25 @@
 #include "othello/OthelloRules.hpp"
 #include "othello/Constants.hpp" // for bitboard constants
 #include "othello/GameBoard.hpp" // for GameBoard and Color
+#include "othello/MoveGen.hpp"   // for the active kernels
 
 #include <bit>
 #include <utility> // for std::pair
-#include <vector>
 
 namespace othello {
 
 uint64_t getPossibleMoves(const GameBoard &b, Color color) {
   uint64_t my_board = color == Color::BLACK ? b.black_bb : b.white_bb;
   uint64_t op_board = color == Color::BLACK ? b.white_bb : b.black_bb;
+  return getMoves(my_board, op_board);
+}
 
-  std::vector<int> possible_moves;
-  uint64_t empty = ~(my_board | op_board);
+uint64_t getMoves(uint64_t my_board, uint64_t op_board) {
+  return activeMoveGen().moves(my_board, op_board);
+}
 
-  uint64_t moves = getDirectionalMoves(my_board, op_board, empty, -1,
-                                       othello::LEFT_EDGE_MASK); // West
-  moves |= getDirectionalMoves(my_board, op_board, empty, 1,
-                               othello::RIGHT_EDGE_MASK); // East
-  moves |= getDirectionalMoves(my_board, op_board, empty, 8,
-                               othello::BOTTOM_EDGE_MASK); // South
-  moves |= getDirectionalMoves(my_board, op_board, empty, -8,
-                               othello::TOP_EDGE_MASK); // North
-  moves |= getDirectionalMoves(my_board, op_board, empty, -7,
-                               othello::TOP_EDGE_MASK &
-                                   othello::RIGHT_EDGE_MASK); // North-East
-  moves |= getDirectionalMoves(my_board, op_board, empty, -9,
-                               othello::TOP_EDGE_MASK &
-                                   othello::LEFT_EDGE_MASK); // North-West
-  moves |= getDirectionalMoves(my_board, op_board, empty, 7,
-                               othello::BOTTOM_EDGE_MASK &
-                                   othello::LEFT_EDGE_MASK); // South-West
-  moves |= getDirectionalMoves(my_board, op_board, empty, 9,
-                               othello::BOTTOM_EDGE_MASK &
-                                   othello::RIGHT_EDGE_MASK); // South-East
-  return moves;
+uint64_t getFlips(uint64_t my_board, uint64_t op_board, int position) {
+  return activeMoveGen().flips(my_board, op_board, position);
 }
 
 bool isValidMove(const GameBoard &b, int position, Color color) {
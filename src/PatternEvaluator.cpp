@@ -0,0 +1,320 @@
+// Copyright (c) 2026 Alex Li
+// PatternEvaluator.cpp
+// Implementation of the PatternEvaluator class for Othello game
+
+#include "othello/evaluator/PatternEvaluator.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstring>
+#include <fstream>
+#include <stdexcept>
+#include <utility>
+
+#include "othello/Symmetry.hpp"
+#include "utils/BitboardUtils.hpp"
+
+namespace othello {
+namespace {
+
+/// @brief One pattern: its squares in the canonical orientation and the
+///        board symmetries that map each of its placements onto them
+struct Pattern {
+  uint64_t mask;
+  int size; // Number of squares
+  int placements;
+  std::array<int, kSymmetries> symmetries;
+};
+
+// Symmetry numbers follow othello::transform(): 0 identity, 1 left-right,
+// 2 top-bottom, 3 both, 4-7 the same followed by the main diagonal
+constexpr std::array<Pattern, 11> kPatterns = {{
+    // Edge row plus both X squares
+    {0x00000000000042FFULL, 10, 4, {0, 2, 4, 5}},
+    // 3x3 corner block
+    {0x0000000000070707ULL, 9, 4, {0, 1, 2, 3}},
+    // 2x5 corner block, both orientations in every corner
+    {0x0000000000001F1FULL, 10, 8, {0, 1, 2, 3, 4, 5, 6, 7}},
+    // Second, third and fourth rows
+    {0x000000000000FF00ULL, 8, 4, {0, 2, 4, 5}},
+    {0x0000000000FF0000ULL, 8, 4, {0, 2, 4, 5}},
+    {0x00000000FF000000ULL, 8, 4, {0, 2, 4, 5}},
+    // Main diagonals
+    {0x8040201008040201ULL, 8, 2, {0, 1}},
+    // Shorter diagonals of length 7, 6, 5 and 4
+    {0x0080402010080402ULL, 7, 4, {0, 1, 2, 4}},
+    {0x0000804020100804ULL, 6, 4, {0, 1, 2, 4}},
+    {0x0000008040201008ULL, 5, 4, {0, 1, 2, 4}},
+    {0x0000000080402010ULL, 4, 4, {0, 1, 2, 4}},
+}};
+
+constexpr int kMaxPatternSize = 10;
+
+constexpr uint32_t pow3(int n) { return n == 0 ? 1 : 3 * pow3(n - 1); }
+
+/// Start of each pattern's table within a phase
+constexpr std::array<uint32_t, kPatterns.size()> kTableOffsets = [] {
+  std::array<uint32_t, kPatterns.size()> offsets{};
+  uint32_t offset = 0;
+  for (size_t i = 0; i < kPatterns.size(); ++i) {
+    offsets[i] = offset;
+    offset += pow3(kPatterns[i].size);
+  }
+  return offsets;
+}();
+
+static_assert([] {
+  size_t instances = 0;
+  size_t weights = 0;
+  for (const Pattern &pattern : kPatterns) {
+    instances += pattern.placements;
+    weights += pow3(pattern.size);
+    if (std::popcount(pattern.mask) != pattern.size ||
+        pattern.size > kMaxPatternSize) {
+      return false;
+    }
+  }
+  return instances == PatternEvaluator::kInstances &&
+         weights == PatternEvaluator::kWeightsPerPhase;
+}());
+
+/// Base-3 value of a binary pattern code: bit i becomes ternary digit i
+constexpr std::array<uint16_t, 1 << kMaxPatternSize> kTernary = [] {
+  std::array<uint16_t, 1 << kMaxPatternSize> ternary{};
+  for (uint32_t bits = 0; bits < ternary.size(); ++bits) {
+    for (int i = 0; i < kMaxPatternSize; ++i) {
+      if (bits & (1U << i)) {
+        ternary[bits] += static_cast<uint16_t>(pow3(i));
+      }
+    }
+  }
+  return ternary;
+}();
+
+/// Table offset of every instance, in the order features() lists them
+constexpr std::array<uint32_t, PatternEvaluator::kInstances> kInstanceOffsets =
+    [] {
+      std::array<uint32_t, PatternEvaluator::kInstances> offsets{};
+      size_t instance = 0;
+      for (size_t p = 0; p < kPatterns.size(); ++p) {
+        for (int i = 0; i < kPatterns[p].placements; ++i) {
+          offsets[instance++] = kTableOffsets[p];
+        }
+      }
+      return offsets;
+    }();
+
+/// @brief A pattern instance covering a square, and the square's digit
+///        value (a power of three) in that instance's code
+struct SquareTerm {
+  uint8_t instance;
+  uint16_t place;
+};
+
+/// Most instances covering any one square (the X squares)
+constexpr int kMaxSquareTerms = 8;
+
+struct SquareTerms {
+  std::array<SquareTerm, kMaxSquareTerms> terms;
+  int count;
+};
+
+/// Every instance each square contributes to, for incremental updates
+constexpr std::array<SquareTerms, 64> kSquareTerms = [] {
+  std::array<SquareTerms, 64> squares{};
+  size_t instance = 0;
+  for (const Pattern &pattern : kPatterns) {
+    for (int i = 0; i < pattern.placements; ++i, ++instance) {
+      for (int square = 0; square < 64; ++square) {
+        const uint64_t bit = transform(1ULL << square, pattern.symmetries[i]);
+        if (bit & pattern.mask) {
+          const int digit = std::popcount(pattern.mask & (bit - 1));
+          SquareTerms &entry = squares[square];
+          entry.terms[entry.count++] = {static_cast<uint8_t>(instance),
+                                        static_cast<uint16_t>(pow3(digit))};
+        }
+      }
+    }
+  }
+  return squares;
+}();
+
+/// Header of a weights file
+struct FileHeader {
+  char magic[4];
+  uint32_t version;
+  uint32_t phases;
+  uint32_t weights_per_phase;
+};
+
+constexpr char kMagic[4] = {'O', 'T', 'P', 'W'};
+constexpr uint32_t kFileVersion = 1;
+
+/// Weights files are little-endian; converts in either direction
+template <typename T> T fileOrder(T value) {
+  if constexpr (std::endian::native == std::endian::big) {
+    return std::byteswap(value);
+  }
+  return value;
+}
+
+} // namespace
+
+PatternEvaluator::PatternEvaluator()
+    : weights(static_cast<size_t>(kPhases) * kWeightsPerPhase, 0) {}
+
+PatternEvaluator::PatternEvaluator(const std::string &weights_path)
+    : PatternEvaluator() {
+  load(weights_path);
+}
+
+int PatternEvaluator::evaluate(const GameBoard &board) const {
+  if (board.current_turn == Color::BLACK) {
+    return evaluate(board.black_bb, board.white_bb);
+  }
+  return -evaluate(board.white_bb, board.black_bb);
+}
+
+int PatternEvaluator::evaluate(uint64_t player, uint64_t opponent) const {
+  Features indices;
+  features(player, opponent, indices);
+  const int16_t *table = phaseWeights(phase(player, opponent));
+  int score = 0;
+  for (uint32_t index : indices) {
+    score += table[index];
+  }
+  return score;
+}
+
+// Accumulator codes [0, kInstances) read black as the side to move, the
+// next kInstances read white as the side to move
+void PatternEvaluator::reset(const GameBoard &board,
+                             EvalAccumulator &accumulator) const {
+  Features indices;
+  features(board.black_bb, board.white_bb, indices);
+  for (size_t i = 0; i < kInstances; ++i) {
+    accumulator.codes[i] =
+        static_cast<uint16_t>(indices[i] - kInstanceOffsets[i]);
+  }
+  features(board.white_bb, board.black_bb, indices);
+  for (size_t i = 0; i < kInstances; ++i) {
+    accumulator.codes[kInstances + i] =
+        static_cast<uint16_t>(indices[i] - kInstanceOffsets[i]);
+  }
+}
+
+void PatternEvaluator::update(EvalAccumulator &accumulator, int move,
+                              uint64_t flips, Color color) const {
+  // A mover's digit is 1 and an opponent's 2 in the mover's own codes, the
+  // other way round in the opponent's
+  uint16_t *mover = accumulator.codes.data();
+  uint16_t *other = accumulator.codes.data() + kInstances;
+  if (color == Color::WHITE) {
+    std::swap(mover, other);
+  }
+  const SquareTerms &placed = kSquareTerms[move];
+  for (int t = 0; t < placed.count; ++t) {
+    const SquareTerm term = placed.terms[t];
+    mover[term.instance] += term.place;
+    other[term.instance] += 2 * term.place;
+  }
+  for (; flips; flips &= flips - 1) {
+    const SquareTerms &flipped = kSquareTerms[std::countr_zero(flips)];
+    for (int t = 0; t < flipped.count; ++t) {
+      const SquareTerm term = flipped.terms[t];
+      mover[term.instance] -= term.place;
+      other[term.instance] += term.place;
+    }
+  }
+}
+
+int PatternEvaluator::evaluate(const GameBoard &board,
+                               const EvalAccumulator &accumulator) const {
+  const bool black = board.current_turn == Color::BLACK;
+  const uint16_t *codes =
+      accumulator.codes.data() + (black ? 0 : kInstances);
+  const int16_t *table = phaseWeights(phase(board.black_bb, board.white_bb));
+  int score = 0;
+  for (size_t i = 0; i < kInstances; ++i) {
+    score += table[kInstanceOffsets[i] + codes[i]];
+  }
+  return black ? score : -score;
+}
+
+int PatternEvaluator::phase(uint64_t player, uint64_t opponent) {
+  const int discs = std::popcount(player | opponent);
+  return std::min(kPhases - 1, std::max(0, discs - 4) / 5);
+}
+
+void PatternEvaluator::features(uint64_t player, uint64_t opponent,
+                                Features &features) {
+  std::array<uint64_t, kSymmetries> players;
+  std::array<uint64_t, kSymmetries> opponents;
+  for (int symmetry = 0; symmetry < kSymmetries; ++symmetry) {
+    players[symmetry] = transform(player, symmetry);
+    opponents[symmetry] = transform(opponent, symmetry);
+  }
+
+  size_t instance = 0;
+  for (size_t p = 0; p < kPatterns.size(); ++p) {
+    const Pattern &pattern = kPatterns[p];
+    for (int i = 0; i < pattern.placements; ++i) {
+      const int symmetry = pattern.symmetries[i];
+      features[instance++] =
+          kTableOffsets[p] +
+          kTernary[extractBits(players[symmetry], pattern.mask)] +
+          2U * kTernary[extractBits(opponents[symmetry], pattern.mask)];
+    }
+  }
+}
+
+void PatternEvaluator::load(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  if (!in) {
+    throw std::runtime_error("cannot open weights file " + path);
+  }
+  FileHeader header{};
+  in.read(reinterpret_cast<char *>(&header), sizeof(header));
+  if (!in || std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0) {
+    throw std::runtime_error(path + " is not a pattern weights file");
+  }
+  if (fileOrder(header.version) != kFileVersion ||
+      fileOrder(header.phases) != static_cast<uint32_t>(kPhases) ||
+      fileOrder(header.weights_per_phase) != kWeightsPerPhase) {
+    throw std::runtime_error(path + " does not match this pattern layout");
+  }
+
+  std::vector<int16_t> loaded(weights.size());
+  in.read(reinterpret_cast<char *>(loaded.data()),
+          static_cast<std::streamsize>(loaded.size() * sizeof(int16_t)));
+  if (!in) {
+    throw std::runtime_error(path + " is truncated");
+  }
+  for (int16_t &weight : loaded) {
+    weight = fileOrder(weight);
+  }
+  weights = std::move(loaded);
+}
+
+void PatternEvaluator::save(const std::string &path) const {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  FileHeader header{};
+  std::memcpy(header.magic, kMagic, sizeof(kMagic));
+  header.version = fileOrder(kFileVersion);
+  header.phases = fileOrder(static_cast<uint32_t>(kPhases));
+  header.weights_per_phase =
+      fileOrder(static_cast<uint32_t>(kWeightsPerPhase));
+  out.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  std::vector<int16_t> stored(weights.size());
+  std::transform(weights.begin(), weights.end(), stored.begin(),
+                 fileOrder<int16_t>);
+  out.write(reinterpret_cast<const char *>(stored.data()),
+            static_cast<std::streamsize>(stored.size() * sizeof(int16_t)));
+  if (!out) {
+    throw std::runtime_error("cannot write weights file " + path);
+  }
+}
+
+} // namespace othello
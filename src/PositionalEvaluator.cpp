@@ -5,8 +5,14 @@
 #include "othello/Constants.hpp"
 #include "othello/GameBoard.hpp"
 #include "othello/evaluator/Evaluator.hpp"
+#include "othello/evaluator/SquareWeights.hpp"
 
 namespace othello {
+namespace {
+// The weights evaluate() applies region by region, as one table
+constexpr SquareWeights kWeights = makeSquareWeights(50, -50, -20, 10, 2, 3, 1);
+} // namespace
+
 int PositionalEvaluator::evaluate(const GameBoard &board) const {
   int score = 0;
 
@@ -33,5 +39,20 @@ int PositionalEvaluator::evaluate(const GameBoard &board) const {
 
   return score;
 }
+
+void PositionalEvaluator::reset(const GameBoard &board,
+                                EvalAccumulator &accumulator) const {
+  accumulator.score = squareScore(kWeights, board);
+}
+
+void PositionalEvaluator::update(EvalAccumulator &accumulator, int move,
+                                 uint64_t flips, Color color) const {
+  accumulator.score += squareScoreDelta(kWeights, move, flips, color);
+}
+
+int PositionalEvaluator::evaluate(const GameBoard &,
+                                  const EvalAccumulator &accumulator) const {
+  return accumulator.score;
+}
 } // namespace othello
 
@@ -0,0 +1,172 @@
+// Copyright (c) 2026 Alex Li
+// ResultCache.cpp
+// Implementation of the search result cache
+
+#include "othello/ResultCache.hpp"
+
+#include <algorithm>
+#include <bit>
+
+#include "othello/Hash.hpp"
+#include "othello/Symmetry.hpp"
+
+namespace othello {
+
+namespace {
+
+/// Rough heap cost of one index entry: a hash node plus its bucket pointer
+constexpr size_t kIndexBytesPerEntry = 64;
+
+/// @brief Map a move through a symmetry, leaving "no move" alone
+int transformMove(int move, int symmetry) {
+  return move < 0 ? move : transformSquare(move, symmetry);
+}
+
+int untransformMove(int move, int symmetry) {
+  return move < 0 ? move : untransformSquare(move, symmetry);
+}
+
+} // namespace
+
+size_t ResultCache::KeyHash::operator()(const Key &key) const {
+  const uint64_t limits =
+      (static_cast<uint64_t>(key.depth) << 8 | key.time_bucket) *
+      0x9E3779B97F4A7C15ULL;
+  return mixBitboards(key.black_bb, key.white_bb) ^ limits ^
+         (key.color == Color::BLACK ? zobrist_black_turn : 0);
+}
+
+ResultCache::ResultCache(size_t budget_bytes)
+    : slot_capacity(budget_bytes / (sizeof(Slot) + kIndexBytesPerEntry)) {
+  slots.reserve(slot_capacity);
+  index.reserve(slot_capacity);
+  counters.capacity = slot_capacity;
+}
+
+std::optional<CachedSearch>
+ResultCache::lookup(const GameBoard &board, Color color, uint8_t depth,
+                    int time_limit_ms, const Search &search,
+                    Outcome *outcome, const WaitLimit &wait_limit) {
+  const CanonicalBoards canonical =
+      canonicalize(board.black_bb, board.white_bb);
+  const Key key{canonical.first, canonical.second, color, depth,
+                static_cast<uint8_t>(std::bit_width(
+                    static_cast<unsigned>(std::max(time_limit_ms, 0))))};
+  auto answer = [&](Outcome how, std::optional<CachedSearch> result) {
+    if (outcome != nullptr) {
+      *outcome = how;
+    }
+    if (result) {
+      result->best_move =
+          untransformMove(result->best_move, canonical.symmetry);
+    }
+    return result;
+  };
+
+  std::shared_ptr<Flight> flight;
+  {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (true) {
+      if (const auto found = index.find(key); found != index.end()) {
+        Slot &slot = slots[found->second];
+        slot.referenced = true;
+        ++counters.hits;
+        return answer(Outcome::HIT, slot.result);
+      }
+      const auto found = in_flight.find(key);
+      if (found == in_flight.end()) {
+        break;
+      }
+      // Keep the flight alive; the searching request erases it when done
+      const std::shared_ptr<Flight> pending = found->second;
+      ++counters.coalesced;
+      if (!waitFor(lock, *pending, wait_limit)) {
+        return answer(Outcome::GAVE_UP, std::nullopt);
+      }
+      if (pending->result && pending->result->cacheable) {
+        return answer(Outcome::COALESCED, pending->result);
+      }
+      // Failed, or cut short by its own request's limits, which need not be
+      // ours: look again, and search ourselves if nobody else does
+    }
+    ++counters.misses;
+    flight = std::make_shared<Flight>();
+    in_flight.emplace(key, flight);
+  }
+
+  // Search without the lock; waiters are released even if it throws
+  std::optional<CachedSearch> result;
+  auto finish = [&] {
+    std::lock_guard<std::mutex> lock(mutex);
+    if (result && result->cacheable) {
+      insert(key, *result);
+    }
+    flight->result = result;
+    flight->done = true;
+    in_flight.erase(key);
+    flight->finished.notify_all();
+  };
+  try {
+    result = search();
+  } catch (...) {
+    result.reset();
+    finish();
+    throw;
+  }
+  if (result) {
+    result->best_move = transformMove(result->best_move, canonical.symmetry);
+  }
+  finish();
+  return answer(Outcome::MISS, result);
+}
+
+bool ResultCache::waitFor(std::unique_lock<std::mutex> &lock, Flight &flight,
+                          const WaitLimit &wait_limit) {
+  while (!flight.done) {
+    if (wait_limit.stop && wait_limit.stop()) {
+      return false;
+    }
+    const auto now = std::chrono::steady_clock::now();
+    if (now >= wait_limit.deadline) {
+      return false;
+    }
+    // Without a stop predicate only the deadline needs a wakeup
+    const auto until =
+        wait_limit.stop && wait_limit.deadline - now > kStopPollInterval
+            ? now + kStopPollInterval
+            : wait_limit.deadline;
+    flight.finished.wait_until(lock, until);
+  }
+  return true;
+}
+
+void ResultCache::insert(const Key &key, const CachedSearch &result) {
+  if (slot_capacity == 0) {
+    return;
+  }
+  if (slots.size() < slot_capacity) {
+    index.emplace(key, slots.size());
+    slots.push_back({key, result, false});
+    return;
+  }
+  // CLOCK: give every referenced slot a second chance on the way round
+  while (slots[hand].referenced) {
+    slots[hand].referenced = false;
+    hand = (hand + 1) % slot_capacity;
+  }
+  Slot &victim = slots[hand];
+  index.erase(victim.key);
+  ++counters.evictions;
+  victim = {key, result, false};
+  index.emplace(key, hand);
+  hand = (hand + 1) % slot_capacity;
+}
+
+ResultCache::Stats ResultCache::stats() const {
+  std::lock_guard<std::mutex> lock(mutex);
+  Stats result = counters;
+  result.entries = slots.size();
+  return result;
+}
+
+} // namespace othello
@@ -0,0 +1,132 @@
+// Copyright (c) 2026 Alex Li
+// TimeManager.cpp
+// Implementation of per-move time allocation
+
+#include "othello/TimeManager.hpp"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace othello {
+
+namespace {
+
+/// Share of the clock kept back for move overhead, at most kMaxReserveMs
+constexpr int kReserveDivisor = 20;
+constexpr int kMaxReserveMs = 2000;
+
+/// Share of the increment spent on the move it is added for
+constexpr double kIncrementShare = 0.75;
+
+/// The hard limit is at most this many soft limits, and at most half of the
+/// usable clock
+constexpr int kHardLimitFactor = 3;
+
+/// Soft limit scaling while the best move keeps changing or holds
+constexpr double kUnstableFactor = 1.5;
+constexpr double kStableFactor = 0.8;
+constexpr double kVeryStableFactor = 0.6;
+
+/// Iterations without a new best move before the soft limit shrinks
+constexpr int kStableIterations = 2;
+constexpr int kVeryStableIterations = 4;
+
+/// Predicted growth from one iteration to the next without enough samples,
+/// and the range predictions are kept in
+constexpr double kDefaultGrowth = 4.0;
+constexpr double kMinGrowth = 1.0;
+constexpr double kMaxGrowth = 16.0;
+
+/// Iterations smaller than this were mostly answered by the transposition
+/// table and say nothing about the cost of the next one
+constexpr uint64_t kMinSampleNodes = 256;
+
+/// @brief Relative time for a move with empties empty squares
+/// @details The opening is shallow tactics or book moves, and the midgame is
+///          where games are decided. Endgame positions need less as the
+///          solver takes over.
+double phaseWeight(int empties) {
+  if (empties >= 46) {
+    return 0.6;
+  }
+  if (empties >= 26) {
+    return 1.4;
+  }
+  return 1.0;
+}
+
+} // namespace
+
+MoveBudget TimeManager::allocate(const GameClock &clock, int empties) {
+  const int remaining = std::max(clock.remaining_ms, 0);
+  const int usable =
+      remaining - std::min(remaining / kReserveDivisor, kMaxReserveMs);
+  // Our own moves are every other ply until the board is full
+  double weights = 0;
+  for (int e = std::max(empties, 1); e > 0; e -= 2) {
+    weights += phaseWeight(e);
+  }
+  const double share = usable * phaseWeight(empties) / weights;
+  const double increment = std::max(clock.increment_ms, 0) * kIncrementShare;
+  const int soft = static_cast<int>(
+      std::clamp(share + increment, 1.0, std::max(usable, 1) * 1.0));
+  const int hard = static_cast<int>(std::max<int64_t>(
+      soft, std::min<int64_t>(int64_t{soft} * kHardLimitFactor,
+                              std::max(usable / 2, 1))));
+  return {soft, hard};
+}
+
+void TimeManager::iterationCompleted(int move, uint64_t iteration_nodes,
+                                     double elapsed) {
+  stable_iterations = iterations > 0 && move == best_move
+                          ? stable_iterations + 1
+                          : 0;
+  best_move = move;
+  ++iterations;
+  last_iteration_ms = elapsed - completed_at_ms;
+  completed_at_ms = elapsed;
+  nodes = {std::max<uint64_t>(iteration_nodes, 1), nodes[0], nodes[1]};
+}
+
+double TimeManager::softLimitMs() const {
+  double factor = 1.0;
+  if (iterations > 1 && stable_iterations == 0) {
+    factor = kUnstableFactor;
+  } else if (stable_iterations >= kVeryStableIterations) {
+    factor = kVeryStableFactor;
+  } else if (stable_iterations >= kStableIterations) {
+    factor = kStableFactor;
+  }
+  return std::min(move_budget.soft_ms * factor,
+                  static_cast<double>(move_budget.hard_ms));
+}
+
+double TimeManager::predictedIterationMs() const {
+  if (iterations == 0) {
+    return 0;
+  }
+  double growth = kDefaultGrowth;
+  if (iterations >= 2 && nodes[1] >= kMinSampleNodes) {
+    growth = static_cast<double>(nodes[0]) / nodes[1];
+    if (iterations >= 3 && nodes[2] >= kMinSampleNodes) {
+      // Odd and even depths differ in cost, so going from depth d to d + 1
+      // may grow like going from d - 2 to d - 1 did; node counts are noisy,
+      // so the larger estimate is used
+      growth = std::max(growth, static_cast<double>(nodes[1]) / nodes[2]);
+    }
+  }
+  return last_iteration_ms * std::clamp(growth, kMinGrowth, kMaxGrowth);
+}
+
+bool TimeManager::startIteration(double elapsed) const {
+  if (elapsed >= move_budget.hard_ms) {
+    return false;
+  }
+  if (!adaptive || iterations == 0) {
+    return true;
+  }
+  return elapsed < softLimitMs() &&
+         elapsed + predictedIterationMs() <= move_budget.hard_ms;
+}
+
+} // namespace othello
@@ -0,0 +1,115 @@
+// Copyright (c) 2026 Alex Li
+// TranspositionTable.cpp
+// Implementation of the shared transposition table
+
+#include "othello/TranspositionTable.hpp"
+
+#include <bit>
+#include <cstdint>
+
+namespace othello {
+
+namespace {
+// Packed slot layout (64 bits):
+//   bits  0-31 : score (two's complement)
+//   bits 32-39 : depth
+//   bits 40-47 : move index (two's complement)
+//   bits 48-49 : bound type
+//   bit  50    : occupied flag, so an all-zero slot is never a hit
+//   bits 56-63 : generation
+constexpr uint64_t kOccupied = 1ULL << 50;
+
+uint64_t pack(int score, uint8_t depth, BoundType bound_type, int8_t move_index,
+              uint8_t generation) {
+  return static_cast<uint64_t>(static_cast<uint32_t>(score)) |
+         (static_cast<uint64_t>(depth) << 32) |
+         (static_cast<uint64_t>(static_cast<uint8_t>(move_index)) << 40) |
+         (static_cast<uint64_t>(bound_type) << 48) | kOccupied |
+         (static_cast<uint64_t>(generation) << 56);
+}
+
+TTEntry unpack(uint64_t data) {
+  return TTEntry{
+      static_cast<int>(static_cast<uint32_t>(data)),
+      static_cast<uint8_t>(data >> 32),
+      static_cast<BoundType>((data >> 48) & 0x3),
+      static_cast<int8_t>(static_cast<uint8_t>(data >> 40)),
+      static_cast<uint8_t>(data >> 56),
+  };
+}
+
+/// @brief Replacement priority of a slot; lower values are evicted first
+int replacementValue(uint64_t data, uint8_t generation) {
+  if (!(data & kOccupied)) {
+    return -1024; // empty slots always go first
+  }
+  const int depth = static_cast<uint8_t>(data >> 32);
+  const int age = static_cast<uint8_t>(generation - static_cast<uint8_t>(data >> 56));
+  return depth - 8 * age;
+}
+} // namespace
+
+TranspositionTable::TranspositionTable(size_t size_mb) { resize(size_mb); }
+
+void TranspositionTable::resize(size_t size_mb) {
+  size_t bucket_count = (size_mb * 1024 * 1024) / sizeof(Bucket);
+  bucket_count = bucket_count == 0 ? 1 : std::bit_floor(bucket_count);
+  buckets = std::make_unique<Bucket[]>(bucket_count);
+  bucket_mask = bucket_count - 1;
+}
+
+void TranspositionTable::clear() {
+  for (size_t i = 0; i < bucketCount(); ++i) {
+    for (Slot &slot : buckets[i].slots) {
+      slot.check.store(0, std::memory_order_relaxed);
+      slot.data.store(0, std::memory_order_relaxed);
+    }
+  }
+  generation.store(0, std::memory_order_relaxed);
+}
+
+bool TranspositionTable::probe(uint64_t key, TTEntry &entry) const {
+  const Bucket &bucket = buckets[key & bucket_mask];
+  for (const Slot &slot : bucket.slots) {
+    const uint64_t data = slot.data.load(std::memory_order_relaxed);
+    const uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if ((check ^ data) == key && (data & kOccupied)) {
+      entry = unpack(data);
+      return true;
+    }
+  }
+  return false;
+}
+
+void TranspositionTable::store(uint64_t key, int score, uint8_t depth,
+                               BoundType bound_type, int8_t move_index) {
+  Bucket &bucket = buckets[key & bucket_mask];
+  const uint8_t current = generation.load(std::memory_order_relaxed);
+
+  Slot *victim = &bucket.slots[0];
+  int victim_value = INT32_MAX;
+  for (Slot &slot : bucket.slots) {
+    const uint64_t data = slot.data.load(std::memory_order_relaxed);
+    const uint64_t check = slot.check.load(std::memory_order_relaxed);
+    if ((check ^ data) == key && (data & kOccupied)) {
+      // Same position: always refresh, but keep a known best move if the new
+      // result did not produce one.
+      if (move_index < 0) {
+        move_index = unpack(data).move_index;
+      }
+      victim = &slot;
+      break;
+    }
+    const int value = replacementValue(data, current);
+    if (value < victim_value) {
+      victim = &slot;
+      victim_value = value;
+    }
+  }
+
+  const uint64_t data = pack(score, depth, bound_type, move_index, current);
+  victim->data.store(data, std::memory_order_relaxed);
+  victim->check.store(key ^ data, std::memory_order_relaxed);
+}
+
+} // namespace othello
@@ -3,53 +3,132 @@
 // Source code for benchmarking engine performance under repeatable scenarios.
 
 #include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
 #include <chrono>
 #include <cstdint>
 #include <cstdlib>
 #include <iomanip>
 #include <iostream>
 #include <limits>
+#include <memory>
+#include <new>
 #include <random>
 #include <sstream>
 #include <stdexcept>
 #include <string>
+#include <utility>
 #include <vector>
 
 #include "othello/Engine.hpp"
 #include "othello/GameBoard.hpp"
+#include "othello/MoveGen.hpp"
 #include "othello/OthelloRules.hpp"
 #include "othello/evaluator/Evaluator.hpp"
+#include "othello/evaluator/PatternEvaluator.hpp"
 #include "utils/BitboardUtils.hpp"
 #include "utils/Profiler.hpp"
 #include "utils/ThreadPool.hpp"
 
+namespace {
+// Heap allocations made by any thread, counted by the operator new
+// replacement below so the benchmark can verify searches don't allocate
+std::atomic<uint64_t> heap_allocations{0};
+
+// Move generation calls, counted by wrappers around the active kernels when
+// --count-movegen is given. Every thread bumps its own cache line, so
+// counting doesn't serialize parallel searches.
+struct alignas(64) CallCounter {
+  std::atomic<uint64_t> calls{0};
+};
+std::array<CallCounter, 256> movegen_counters;
+std::atomic<size_t> next_movegen_counter{0};
+thread_local CallCounter &movegen_counter =
+    movegen_counters[next_movegen_counter.fetch_add(1) %
+                     movegen_counters.size()];
+
+// The kernels the counting wrappers forward to
+const othello::MoveGenKernels *counted_move_gen = nullptr;
+
+uint64_t countedMoves(uint64_t my_board, uint64_t op_board) {
+  movegen_counter.calls.store(
+      movegen_counter.calls.load(std::memory_order_relaxed) + 1,
+      std::memory_order_relaxed);
+  return counted_move_gen->moves(my_board, op_board);
+}
+
+uint64_t countedFlips(uint64_t my_board, uint64_t op_board, int position) {
+  return counted_move_gen->flips(my_board, op_board, position);
+}
+
+uint64_t movegenCalls() {
+  uint64_t total = 0;
+  for (const CallCounter &counter : movegen_counters) {
+    total += counter.calls.load(std::memory_order_relaxed);
+  }
+  return total;
+}
+} // namespace
+
+void *operator new(std::size_t size) {
+  heap_allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *ptr = std::malloc(size == 0 ? 1 : size)) {
+    return ptr;
+  }
+  throw std::bad_alloc();
+}
+
+void operator delete(void *ptr) noexcept { std::free(ptr); }
+
+void operator delete(void *ptr, std::size_t) noexcept { std::free(ptr); }
+
 namespace {
 
 enum class OutputFormat { Text, Csv, Json };
 
+enum class Mode { Positions, Game, Endgame };
+
 struct Config {
   std::vector<int> depths{1, 5, 10, 13};
   int positions = 10;
   int plies = 20;
-  int threads = 5;
+  int empties = 14;
+  int endgame_empties = othello::kDefaultEndgameEmpties;
+  std::vector<int> threads{5};
+  int tt_size_mb = static_cast<int>(othello::kDefaultTTSizeMB);
   int time_limit_ms = std::numeric_limits<int>::max();
   uint64_t seed = 1738;
   OutputFormat format = OutputFormat::Text;
+  Mode mode = Mode::Positions;
+  othello::SearchMode search_mode = othello::SearchMode::YBWC;
+  othello::SearchDriver search_driver = othello::SearchDriver::ASPIRATION;
+  bool fresh_tt = false;
+  bool history_heuristics = true;
+  int canonical_discs = othello::kDefaultCanonicalDiscs;
+  bool count_movegen = false;
   std::string profile_file = "cpu_profile.prof";
+  std::string weights_file; // Pattern weights; empty uses the mobility evaluator
 };
 
 struct Result {
   int depth = 0;
   int position_index = 0;
+  int move_number = 0;
   int plies = 0;
   int threads = 0;
   uint64_t seed = 0;
   int best_move = -1;
   int score = 0;
   double elapsed_ms = 0.0;
-  int nodes_searched = 0;
+  uint64_t nodes_searched = 0;
   int cache_hits = 0;
   double nodes_per_sec = 0.0;
+  uint64_t allocations = 0;
+  uint64_t movegen_calls = 0;
+  uint64_t cutoffs = 0;
+  uint64_t first_move_cutoffs = 0;
+  int root_searches = 0;
   int completed_depth = 0;
   bool time_limit_hit = false;
 };
@@ -81,26 +160,46 @@ uint64_t parseSeed(const std::string &value) {
   return static_cast<uint64_t>(result);
 }
 
-std::vector<int> parseDepths(const std::string &value) {
-  std::vector<int> depths;
+std::vector<int> parsePositiveIntList(const std::string &value,
+                                      const std::string &name) {
+  std::vector<int> values;
   std::stringstream stream(value);
   std::string item;
   while (std::getline(stream, item, ',')) {
     if (item.empty()) {
-      throw std::invalid_argument("depth list contains an empty item");
+      throw std::invalid_argument(name + " list contains an empty item");
     }
-    int depth = parsePositiveInt(item, "depth");
+    values.push_back(parsePositiveInt(item, name));
+  }
+  if (values.empty()) {
+    throw std::invalid_argument(name + " list must not be empty");
+  }
+  return values;
+}
+
+std::vector<int> parseDepths(const std::string &value) {
+  std::vector<int> depths = parsePositiveIntList(value, "depth");
+  for (int depth : depths) {
     if (depth > std::numeric_limits<uint8_t>::max()) {
       throw std::invalid_argument("depth must fit in uint8_t");
     }
-    depths.push_back(depth);
-  }
-  if (depths.empty()) {
-    throw std::invalid_argument("depth list must not be empty");
   }
   return depths;
 }
 
+Mode parseMode(const std::string &value) {
+  if (value == "positions") {
+    return Mode::Positions;
+  }
+  if (value == "game") {
+    return Mode::Game;
+  }
+  if (value == "endgame") {
+    return Mode::Endgame;
+  }
+  throw std::invalid_argument("mode must be one of: positions, game, endgame");
+}
+
 OutputFormat parseFormat(const std::string &value) {
   if (value == "text") {
     return OutputFormat::Text;
@@ -119,11 +218,34 @@ void printUsage(const char *program) {
       << "Usage: " << program << " [options]\n"
       << "\n"
       << "Options:\n"
+      << "  --mode positions|game|endgame\n"
+      << "                         Search independent positions, play whole\n"
+      << "                         games from each position (engine vs itself),\n"
+      << "                         or solve endgame positions exactly\n"
+      << "  --empties N            Empty squares left in endgame positions\n"
+      << "  --endgame-empties N    Solve exactly at or below N empties in the\n"
+      << "                         other modes; 0 disables\n"
+      << "  --fresh-tt             Clear the transposition table before every\n"
+      << "                         search instead of keeping it across moves\n"
+      << "  --no-history           Disable killer and history move ordering\n"
+      << "  --canonical-discs N    Key positions with at most N discs by their\n"
+      << "                         canonical orientation in the TT; 0 disables\n"
+      << "  --count-movegen        Count move generation calls per node; the\n"
+      << "                         counting slows the search slightly\n"
+      << "  --weights FILE         Evaluate with the pattern evaluator and\n"
+      << "                         these weights\n"
       << "  --depth N              Run one search depth\n"
       << "  --depths A,B,C         Run multiple search depths\n"
       << "  --positions N          Number of deterministic positions per depth\n"
       << "  --plies N              Random legal plies used to create each position\n"
-      << "  --threads N            Thread pool size\n"
+      << "  --threads N[,M,...]    Thread pool size; a list runs every scenario\n"
+      << "                         per size and reports speedup and search\n"
+      << "                         overhead relative to the first size\n"
+      << "  --tt-mb N              Transposition table size in megabytes\n"
+      << "  --search-mode ybwc|lazysmp|serial\n"
+      << "                         Parallel search strategy\n"
+      << "  --driver full|aspiration|mtdf\n"
+      << "                         Root window strategy per iteration\n"
       << "  --time-limit-ms N      Per-search time limit\n"
       << "  --seed N               Deterministic board-generation seed\n"
       << "  --format text|csv|json Output format\n"
@@ -145,6 +267,27 @@ Config parseArgs(int argc, char **argv) {
     if (arg == "--help" || arg == "-h") {
       printUsage(argv[0]);
       std::exit(0);
+    } else if (arg == "--mode") {
+      config.mode = parseMode(requireValue(arg));
+    } else if (arg == "--empties") {
+      config.empties = parsePositiveInt(requireValue(arg), "empties");
+      if (config.empties > 60) {
+        throw std::invalid_argument("empties must be at most 60");
+      }
+    } else if (arg == "--endgame-empties") {
+      config.endgame_empties =
+          parseNonNegativeInt(requireValue(arg), "endgame-empties");
+    } else if (arg == "--fresh-tt") {
+      config.fresh_tt = true;
+    } else if (arg == "--no-history") {
+      config.history_heuristics = false;
+    } else if (arg == "--canonical-discs") {
+      config.canonical_discs =
+          parseNonNegativeInt(requireValue(arg), "canonical-discs");
+    } else if (arg == "--count-movegen") {
+      config.count_movegen = true;
+    } else if (arg == "--weights") {
+      config.weights_file = requireValue(arg);
     } else if (arg == "--depth") {
       config.depths = parseDepths(requireValue(arg));
     } else if (arg == "--depths") {
@@ -154,7 +297,23 @@ Config parseArgs(int argc, char **argv) {
     } else if (arg == "--plies") {
       config.plies = parseNonNegativeInt(requireValue(arg), "plies");
     } else if (arg == "--threads") {
-      config.threads = parsePositiveInt(requireValue(arg), "threads");
+      config.threads = parsePositiveIntList(requireValue(arg), "threads");
+    } else if (arg == "--search-mode") {
+      const std::string value = requireValue(arg);
+      const auto mode = othello::parseSearchMode(value);
+      if (!mode) {
+        throw std::invalid_argument("search-mode must be one of: ybwc, lazysmp, serial");
+      }
+      config.search_mode = *mode;
+    } else if (arg == "--driver") {
+      const auto driver = othello::parseSearchDriver(requireValue(arg));
+      if (!driver) {
+        throw std::invalid_argument(
+            "driver must be one of: full, aspiration, mtdf");
+      }
+      config.search_driver = *driver;
+    } else if (arg == "--tt-mb") {
+      config.tt_size_mb = parsePositiveInt(requireValue(arg), "tt-mb");
     } else if (arg == "--time-limit-ms") {
       config.time_limit_ms =
           parsePositiveInt(requireValue(arg), "time-limit-ms");
@@ -204,67 +363,230 @@ std::vector<othello::GameBoard> getRandomBoards(int num_boards,
   return boards;
 }
 
+/// @brief Play random games until exactly `empties` squares are left
+/// @return The positions and the color to move in each
+std::vector<std::pair<othello::GameBoard, othello::Color>>
+getEndgameBoards(int num_boards, int empties, uint64_t seed) {
+  std::vector<std::pair<othello::GameBoard, othello::Color>> boards;
+  boards.reserve(static_cast<size_t>(num_boards));
+  std::mt19937_64 rng(seed);
+  while (static_cast<int>(boards.size()) < num_boards) {
+    othello::GameBoard board = othello::createInitialBoard();
+    othello::Color color = othello::Color::BLACK;
+    while (64 - std::popcount(board.black_bb | board.white_bb) > empties) {
+      std::vector<int> moves = othello::bitboard_to_positions(
+          othello::getPossibleMoves(board, color));
+      if (moves.empty()) {
+        color = othello::opponent(color);
+        moves = othello::bitboard_to_positions(
+            othello::getPossibleMoves(board, color));
+        if (moves.empty()) {
+          break; // Game ended early; try another one
+        }
+      }
+      board = othello::applyMove(board, moves[rng() % moves.size()], color);
+      color = othello::opponent(color);
+    }
+    if (othello::getPossibleMoves(board, color) == 0) {
+      color = othello::opponent(color);
+    }
+    if (64 - std::popcount(board.black_bb | board.white_bb) == empties &&
+        othello::getPossibleMoves(board, color) != 0) {
+      boards.emplace_back(board, color);
+    }
+  }
+  return boards;
+}
+
+Result measureSearch(othello::Engine &engine, const othello::GameBoard &board,
+                     othello::Color color, int depth, int threads,
+                     const Config &config) {
+  if (config.fresh_tt) {
+    engine.newGame();
+  }
+  const uint64_t allocations_before = heap_allocations.load();
+  const uint64_t movegen_before = movegenCalls();
+  auto start = std::chrono::steady_clock::now();
+  int best_move = engine.findBestMove(board, static_cast<uint8_t>(depth), color,
+                                      config.time_limit_ms);
+  auto end = std::chrono::steady_clock::now();
+  const uint64_t allocations = heap_allocations.load() - allocations_before;
+  const uint64_t movegen_calls = movegenCalls() - movegen_before;
+
+  const std::chrono::duration<double, std::milli> elapsed = end - start;
+  const othello::SearchStats stats = engine.lastSearchStats();
+  const double elapsed_seconds = elapsed.count() / 1000.0;
+
+  return Result{
+      .depth = depth,
+      .plies = config.plies,
+      .threads = threads,
+      .seed = config.seed,
+      .best_move = best_move,
+      .score = stats.score,
+      .elapsed_ms = elapsed.count(),
+      .nodes_searched = stats.nodes_searched,
+      .cache_hits = stats.cache_hits,
+      .nodes_per_sec =
+          elapsed_seconds > 0.0 ? stats.nodes_searched / elapsed_seconds : 0.0,
+      .allocations = allocations,
+      .movegen_calls = movegen_calls,
+      .cutoffs = stats.cutoffs,
+      .first_move_cutoffs = stats.first_move_cutoffs,
+      .root_searches = stats.root_searches,
+      .completed_depth = stats.completed_depth,
+      .time_limit_hit = stats.time_limit_hit,
+  };
+}
+
+/// @brief Solve each endgame position exactly, recording one result per
+///        position
+void solveEndgames(othello::Engine &engine, int threads, const Config &config,
+                   std::vector<Result> &results) {
+  const auto boards =
+      getEndgameBoards(config.positions, config.empties, config.seed);
+  for (size_t position = 0; position < boards.size(); ++position) {
+    if (config.fresh_tt) {
+      engine.newGame();
+    }
+    const auto &[board, color] = boards[position];
+    const uint64_t allocations_before = heap_allocations.load();
+    const uint64_t movegen_before = movegenCalls();
+    auto start = std::chrono::steady_clock::now();
+    int best_move = engine.solveEndgame(board, color);
+    auto end = std::chrono::steady_clock::now();
+    const uint64_t allocations = heap_allocations.load() - allocations_before;
+    const uint64_t movegen_calls = movegenCalls() - movegen_before;
+
+    const std::chrono::duration<double, std::milli> elapsed = end - start;
+    const othello::SearchStats stats = engine.lastSearchStats();
+    const double elapsed_seconds = elapsed.count() / 1000.0;
+    results.push_back(Result{
+        .depth = config.empties,
+        .position_index = static_cast<int>(position),
+        .threads = threads,
+        .seed = config.seed,
+        .best_move = best_move,
+        .score = stats.score,
+        .elapsed_ms = elapsed.count(),
+        .nodes_searched = stats.nodes_searched,
+        .nodes_per_sec = elapsed_seconds > 0.0
+                             ? stats.nodes_searched / elapsed_seconds
+                             : 0.0,
+        .allocations = allocations,
+        .movegen_calls = movegen_calls,
+        .completed_depth = stats.completed_depth,
+    });
+  }
+}
+
+/// @brief Play each board to the end with the engine moving for both sides,
+///        recording one result per search
+void playGames(othello::Engine &engine,
+               const std::vector<othello::GameBoard> &boards, int depth,
+               int threads, const Config &config,
+               std::vector<Result> &results) {
+  for (size_t game = 0; game < boards.size(); ++game) {
+    engine.newGame();
+    othello::GameBoard board = boards[game];
+    othello::Color color = othello::Color::BLACK;
+    int move_number = 0;
+    while (!othello::isTerminal(board)) {
+      if (othello::getPossibleMoves(board, color) == 0) {
+        color = othello::opponent(color);
+        continue;
+      }
+      Result result =
+          measureSearch(engine, board, color, depth, threads, config);
+      result.position_index = static_cast<int>(game);
+      result.move_number = move_number++;
+      results.push_back(result);
+      board = othello::applyMove(board, result.best_move, color);
+      color = othello::opponent(color);
+    }
+  }
+}
+
 std::vector<Result> runBenchmark(const Config &config) {
   othello::initializeZobrist();
 
-  othello::MobilityEvaluator evaluator;
-  utils::ThreadPool thread_pool(static_cast<size_t>(config.threads));
-  othello::Engine engine(evaluator, thread_pool);
-  engine.setVerbose(false);
-
+  std::unique_ptr<othello::Evaluator> evaluator;
+  if (config.weights_file.empty()) {
+    evaluator = std::make_unique<othello::MobilityEvaluator>();
+  } else {
+    evaluator = std::make_unique<othello::PatternEvaluator>(config.weights_file);
+  }
   const auto boards = getRandomBoards(config.positions, config.plies, config.seed);
   std::vector<Result> results;
-  results.reserve(config.depths.size() * boards.size());
+
+  // Installed after the boards are built so only searches are counted
+  othello::MoveGenKernels counting_kernels{};
+  if (config.count_movegen) {
+    counted_move_gen = &othello::activeMoveGen();
+    counting_kernels = {counted_move_gen->level, countedMoves, countedFlips};
+    othello::installMoveGen(counting_kernels);
+  }
+  results.reserve(config.threads.size() * config.depths.size() * boards.size());
 
   utils::profiler::start(config.profile_file.c_str());
-  for (int depth : config.depths) {
-    for (size_t position = 0; position < boards.size(); ++position) {
-      auto start = std::chrono::steady_clock::now();
-      int best_move = engine.findBestMove(
-          boards[position], static_cast<uint8_t>(depth), othello::Color::BLACK,
-          config.time_limit_ms);
-      auto end = std::chrono::steady_clock::now();
-
-      const std::chrono::duration<double, std::milli> elapsed = end - start;
-      const othello::SearchStats stats = engine.lastSearchStats();
-      const double elapsed_seconds = elapsed.count() / 1000.0;
-
-      results.push_back(Result{
-          .depth = depth,
-          .position_index = static_cast<int>(position),
-          .plies = config.plies,
-          .threads = config.threads,
-          .seed = config.seed,
-          .best_move = best_move,
-          .score = stats.score,
-          .elapsed_ms = elapsed.count(),
-          .nodes_searched = stats.nodes_searched,
-          .cache_hits = stats.cache_hits,
-          .nodes_per_sec = elapsed_seconds > 0.0
-                               ? stats.nodes_searched / elapsed_seconds
-                               : 0.0,
-          .completed_depth = stats.completed_depth,
-          .time_limit_hit = stats.time_limit_hit,
-      });
+  for (int threads : config.threads) {
+    // Fresh pool and engine per thread count so every size starts cold
+    utils::ThreadPool thread_pool(static_cast<size_t>(threads));
+    othello::Engine engine(*evaluator, thread_pool,
+                           static_cast<size_t>(config.tt_size_mb));
+    engine.setVerbose(false);
+    engine.setSearchMode(config.search_mode);
+    engine.setEndgameEmpties(config.endgame_empties);
+    engine.setHistoryHeuristics(config.history_heuristics);
+    engine.setCanonicalDiscs(config.canonical_discs);
+    engine.setSearchDriver(config.search_driver);
+
+    if (config.mode == Mode::Endgame) {
+      solveEndgames(engine, threads, config, results);
+      continue;
+    }
+    for (int depth : config.depths) {
+      if (config.mode == Mode::Game) {
+        playGames(engine, boards, depth, threads, config, results);
+        continue;
+      }
+      for (size_t position = 0; position < boards.size(); ++position) {
+        Result result = measureSearch(engine, boards[position],
+                                      othello::Color::BLACK, depth, threads,
+                                      config);
+        result.position_index = static_cast<int>(position);
+        results.push_back(result);
+      }
     }
   }
   utils::profiler::stop();
+  if (config.count_movegen) {
+    othello::installMoveGen(*counted_move_gen);
+  }
 
   return results;
 }
 
 void printCsv(const std::vector<Result> &results) {
-  std::cout << "depth,position_index,plies,threads,seed,best_move,score,"
+  std::cout << "depth,position_index,move_number,plies,threads,seed,"
+               "best_move,score,"
                "elapsed_ms,nodes_searched,cache_hits,nodes_per_sec,"
-               "completed_depth,time_limit_hit\n";
+               "allocations,movegen_calls,cutoffs,first_move_cutoffs,"
+               "root_searches,"
+               "completed_depth,"
+               "time_limit_hit\n";
   std::cout << std::fixed << std::setprecision(3);
   for (const Result &result : results) {
     std::cout << result.depth << ',' << result.position_index << ','
-              << result.plies << ',' << result.threads << ',' << result.seed
+              << result.move_number << ',' << result.plies << ',' << result.threads << ',' << result.seed
               << ',' << result.best_move << ',' << result.score << ','
               << result.elapsed_ms << ',' << result.nodes_searched << ','
               << result.cache_hits << ',' << result.nodes_per_sec << ','
-              << result.completed_depth << ','
+              << result.allocations << ',' << result.movegen_calls << ','
+              << result.cutoffs << ','
+              << result.first_move_cutoffs << ',' << result.root_searches
+              << ',' << result.completed_depth
+              << ','
               << (result.time_limit_hit ? "true" : "false") << '\n';
   }
 }
@@ -277,6 +599,7 @@ void printJson(const std::vector<Result> &results) {
     std::cout << "  {"
               << "\"depth\":" << result.depth << ","
               << "\"position_index\":" << result.position_index << ","
+              << "\"move_number\":" << result.move_number << ","
               << "\"plies\":" << result.plies << ","
               << "\"threads\":" << result.threads << ","
               << "\"seed\":" << result.seed << ","
@@ -286,6 +609,11 @@ void printJson(const std::vector<Result> &results) {
               << "\"nodes_searched\":" << result.nodes_searched << ","
               << "\"cache_hits\":" << result.cache_hits << ","
               << "\"nodes_per_sec\":" << result.nodes_per_sec << ","
+              << "\"allocations\":" << result.allocations << ","
+              << "\"movegen_calls\":" << result.movegen_calls << ","
+              << "\"cutoffs\":" << result.cutoffs << ","
+              << "\"first_move_cutoffs\":" << result.first_move_cutoffs << ","
+              << "\"root_searches\":" << result.root_searches << ","
               << "\"completed_depth\":" << result.completed_depth << ","
               << "\"time_limit_hit\":"
               << (result.time_limit_hit ? "true" : "false") << "}";
@@ -297,15 +625,30 @@ void printJson(const std::vector<Result> &results) {
   std::cout << "]\n";
 }
 
-void printText(const std::vector<Result> &results) {
+void printText(const std::vector<Result> &results, bool count_movegen) {
   std::cout << std::fixed << std::setprecision(3);
   for (const Result &result : results) {
     std::cout << "depth=" << result.depth
               << " position=" << result.position_index
+              << " move=" << result.move_number
               << " elapsed_ms=" << result.elapsed_ms
               << " nodes=" << result.nodes_searched
               << " nodes_per_sec=" << result.nodes_per_sec
               << " cache_hits=" << result.cache_hits
+              << " allocations=" << result.allocations;
+    if (count_movegen) {
+      std::cout << " movegen_per_node="
+                << (result.nodes_searched > 0
+                        ? static_cast<double>(result.movegen_calls) /
+                              static_cast<double>(result.nodes_searched)
+                        : 0.0);
+    }
+    std::cout << " first_move_cutoff_rate="
+              << (result.cutoffs > 0
+                      ? static_cast<double>(result.first_move_cutoffs) /
+                            static_cast<double>(result.cutoffs)
+                      : 0.0)
+              << " root_searches=" << result.root_searches
               << " best_move=" << result.best_move
               << " score=" << result.score
               << " completed_depth=" << result.completed_depth
@@ -314,39 +657,91 @@ void printText(const std::vector<Result> &results) {
   }
 
   std::vector<int> depths;
+  std::vector<int> thread_counts;
   for (const Result &result : results) {
     if (std::find(depths.begin(), depths.end(), result.depth) == depths.end()) {
       depths.push_back(result.depth);
     }
+    if (std::find(thread_counts.begin(), thread_counts.end(),
+                  result.threads) == thread_counts.end()) {
+      thread_counts.push_back(result.threads);
+    }
   }
 
   std::cout << "\nsummary\n";
   for (int depth : depths) {
-    double total_ms = 0.0;
-    double total_nodes = 0.0;
-    int count = 0;
-    for (const Result &result : results) {
-      if (result.depth == depth) {
-        total_ms += result.elapsed_ms;
-        total_nodes += result.nodes_searched;
-        ++count;
+    double base_ms = 0.0;
+    double base_nodes = 0.0;
+    for (int threads : thread_counts) {
+      double total_ms = 0.0;
+      double total_nodes = 0.0;
+      double total_cache_hits = 0.0;
+      double total_allocations = 0.0;
+      double total_movegen_calls = 0.0;
+      double total_cutoffs = 0.0;
+      double total_first_move_cutoffs = 0.0;
+      int count = 0;
+      for (const Result &result : results) {
+        if (result.depth == depth && result.threads == threads) {
+          total_ms += result.elapsed_ms;
+          total_nodes += result.nodes_searched;
+          total_cache_hits += result.cache_hits;
+          total_allocations += result.allocations;
+          total_movegen_calls += result.movegen_calls;
+          total_cutoffs += result.cutoffs;
+          total_first_move_cutoffs += result.first_move_cutoffs;
+          ++count;
+        }
+      }
+      const double avg_ms = count > 0 ? total_ms / count : 0.0;
+      const double avg_nodes = count > 0 ? total_nodes / count : 0.0;
+      const double nodes_per_sec =
+          total_ms > 0.0 ? (total_nodes / (total_ms / 1000.0)) : 0.0;
+      std::cout << "depth=" << depth;
+      if (thread_counts.size() > 1) {
+        std::cout << " threads=" << threads;
+      }
+      std::cout << " runs=" << count
+                << " avg_ms=" << avg_ms
+                << " avg_nodes=" << avg_nodes
+                << " aggregate_nodes_per_sec=" << nodes_per_sec
+                << " allocations_per_node="
+                << (total_nodes > 0.0 ? total_allocations / total_nodes : 0.0);
+      if (count_movegen) {
+        std::cout << " movegen_per_node="
+                  << (total_nodes > 0.0 ? total_movegen_calls / total_nodes
+                                        : 0.0);
+      }
+      // Share of visited positions answered by the transposition table
+      std::cout << " tt_hit_rate="
+                << (total_nodes + total_cache_hits > 0.0
+                        ? total_cache_hits / (total_nodes + total_cache_hits)
+                        : 0.0);
+      std::cout << " first_move_cutoff_rate="
+                << (total_cutoffs > 0.0
+                        ? total_first_move_cutoffs / total_cutoffs
+                        : 0.0);
+      if (thread_counts.size() > 1) {
+        // Scaling relative to the first thread count in the list
+        if (threads == thread_counts.front()) {
+          base_ms = total_ms;
+          base_nodes = total_nodes;
+        }
+        const double speedup = total_ms > 0.0 ? base_ms / total_ms : 0.0;
+        const double overhead =
+            base_nodes > 0.0 ? total_nodes / base_nodes - 1.0 : 0.0;
+        std::cout << " speedup=" << speedup
+                  << " search_overhead=" << overhead;
       }
+      std::cout << '\n';
     }
-    const double avg_ms = count > 0 ? total_ms / count : 0.0;
-    const double avg_nodes = count > 0 ? total_nodes / count : 0.0;
-    const double nodes_per_sec =
-        total_ms > 0.0 ? (total_nodes / (total_ms / 1000.0)) : 0.0;
-    std::cout << "depth=" << depth << " runs=" << count
-              << " avg_ms=" << avg_ms
-              << " avg_nodes=" << avg_nodes
-              << " aggregate_nodes_per_sec=" << nodes_per_sec << '\n';
   }
 }
 
 void printResults(const Config &config, const std::vector<Result> &results) {
   switch (config.format) {
   case OutputFormat::Text:
-    printText(results);
+    printText(results, config.count_movegen);
     break;
   case OutputFormat::Csv:
     printCsv(results);
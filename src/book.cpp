@@ -0,0 +1,281 @@
+// Copyright (c) 2026 Alex Li
+// book.cpp
+// Opening book builder: plays self-play openings, searches every position
+// they reach at high depth, and writes the results as an opening book.
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+#include "othello/Engine.hpp"
+#include "othello/GameBoard.hpp"
+#include "othello/OpeningBook.hpp"
+#include "othello/OthelloRules.hpp"
+#include "othello/Symmetry.hpp"
+#include "othello/evaluator/Evaluator.hpp"
+#include "othello/evaluator/PatternEvaluator.hpp"
+#include "utils/ThreadPool.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+  int games = 500;
+  int plies = 12;
+  int depth = 14;
+  int random_plies = 6;
+  int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  int tt_size_mb = 64;
+  uint64_t seed = 1738;
+  std::string output = "book.bin";
+  std::string weights_file; // Empty uses the mobility evaluator
+};
+
+void printUsage(const char *program) {
+  std::cout
+      << "Usage: " << program << " [options]\n"
+      << "\n"
+      << "  --games N         Self-play openings to play\n"
+      << "  --plies N         Book depth: positions before ply N are searched\n"
+      << "                    and stored\n"
+      << "  --depth N         Search depth for every book position\n"
+      << "  --random-plies N  Plies played at random, so openings differ;\n"
+      << "                    the rest follow the book's own moves\n"
+      << "  --threads N       Openings played at once, and the search pool\n"
+      << "  --tt-mb N         Transposition table size per opening thread\n"
+      << "  --seed N          Deterministic opening seed\n"
+      << "  --weights FILE    Search with the pattern evaluator and these\n"
+      << "                    weights\n"
+      << "  --output FILE     Where to write the book\n"
+      << "  --help            Show this help\n";
+}
+
+int parseInt(const std::string &value, const std::string &name, int minimum) {
+  size_t parsed = 0;
+  const int result = std::stoi(value, &parsed);
+  if (parsed != value.size() || result < minimum) {
+    throw std::invalid_argument(name + " must be an integer >= " +
+                                std::to_string(minimum));
+  }
+  return result;
+}
+
+Config parseArgs(int argc, char **argv) {
+  Config config;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    auto requireValue = [&](const std::string &name) -> std::string {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument(name + " requires a value");
+      }
+      return argv[++i];
+    };
+
+    if (arg == "--help" || arg == "-h") {
+      printUsage(argv[0]);
+      std::exit(0);
+    } else if (arg == "--games") {
+      config.games = parseInt(requireValue(arg), "games", 1);
+    } else if (arg == "--plies") {
+      config.plies = parseInt(requireValue(arg), "plies", 1);
+    } else if (arg == "--depth") {
+      config.depth = parseInt(requireValue(arg), "depth", 1);
+    } else if (arg == "--random-plies") {
+      config.random_plies = parseInt(requireValue(arg), "random-plies", 0);
+    } else if (arg == "--threads") {
+      config.threads = parseInt(requireValue(arg), "threads", 1);
+    } else if (arg == "--tt-mb") {
+      config.tt_size_mb = parseInt(requireValue(arg), "tt-mb", 1);
+    } else if (arg == "--seed") {
+      config.seed = std::stoull(requireValue(arg));
+    } else if (arg == "--weights") {
+      config.weights_file = requireValue(arg);
+    } else if (arg == "--output") {
+      config.output = requireValue(arg);
+    } else {
+      throw std::invalid_argument("unknown option: " + arg);
+    }
+  }
+  if (config.depth > 60) {
+    throw std::invalid_argument("depth must be at most 60");
+  }
+  return config;
+}
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+/// @brief Book positions found so far, by canonical key, shared by every
+///        opening thread
+class BookBuilder {
+ public:
+  /// @brief Count a visit to a position already in the book
+  /// @return Its best move in the canonical orientation, or -1 if the
+  ///         position hasn't been searched yet
+  int visit(uint64_t key) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto found = entries.find(key);
+    if (found == entries.end()) {
+      return -1;
+    }
+    ++found->second.visits;
+    return found->second.move;
+  }
+
+  /// @brief Add a searched position; if another thread got there first its
+  ///        result is kept and this one counts as a visit
+  /// @return The stored best move in the canonical orientation
+  int add(const othello::BookEntry &entry) {
+    std::lock_guard<std::mutex> lock(mutex);
+    const auto [it, inserted] = entries.try_emplace(entry.key, entry);
+    if (!inserted) {
+      ++it->second.visits;
+    }
+    return it->second.move;
+  }
+
+  std::vector<othello::BookEntry> take() {
+    std::lock_guard<std::mutex> lock(mutex);
+    std::vector<othello::BookEntry> result;
+    result.reserve(entries.size());
+    for (const auto &[key, entry] : entries) {
+      result.push_back(entry);
+    }
+    return result;
+  }
+
+ private:
+  std::mutex mutex;
+  std::unordered_map<uint64_t, othello::BookEntry> entries;
+};
+
+/// @brief Play one opening, adding every position before config.plies
+/// @details The first random_plies moves are random so openings differ;
+///          after that each side plays the book move, so later openings
+///          reuse and reinforce the lines already searched.
+void playOpening(othello::Engine &engine, const Config &config, uint64_t seed,
+                 BookBuilder &book, std::atomic<uint64_t> &searches) {
+  std::mt19937_64 rng(seed);
+  othello::GameBoard board = othello::createInitialBoard();
+  for (int ply = 0; ply < config.plies; ++ply) {
+    const othello::Color color = board.current_turn;
+    uint64_t moves = othello::getPossibleMoves(board, color);
+    if (!moves) {
+      return; // applyMove hands the turn over on a pass, so the game is over
+    }
+    const bool black = color == othello::Color::BLACK;
+    const uint64_t player = black ? board.black_bb : board.white_bb;
+    const uint64_t opponent = black ? board.white_bb : board.black_bb;
+    const othello::OpeningBook::Canonical position =
+        othello::OpeningBook::canonical(player, opponent);
+
+    int canonical_move = book.visit(position.key);
+    if (canonical_move < 0) {
+      const int move = engine.findBestMove(
+          board, static_cast<uint8_t>(config.depth), color,
+          std::numeric_limits<int>::max());
+      const othello::SearchStats stats = engine.lastSearchStats();
+      searches.fetch_add(1, std::memory_order_relaxed);
+      canonical_move = book.add(othello::BookEntry{
+          .key = position.key,
+          .score = static_cast<int16_t>(
+              std::clamp(stats.score, -32767, 32767)),
+          .move = static_cast<uint8_t>(
+              othello::transformSquare(move, position.symmetry)),
+          .depth = static_cast<uint8_t>(stats.completed_depth),
+          .visits = 1,
+      });
+    }
+
+    int move;
+    if (ply < config.random_plies) {
+      for (int pick = static_cast<int>(rng() % std::popcount(moves)); pick > 0;
+           --pick) {
+        moves &= moves - 1;
+      }
+      move = std::countr_zero(moves);
+    } else {
+      move = othello::untransformSquare(canonical_move, position.symmetry);
+    }
+    board = othello::applyMove(board, move, color);
+  }
+}
+
+void buildBook(const Config &config, const othello::Evaluator &evaluator) {
+  const auto start = Clock::now();
+  utils::ThreadPool thread_pool(static_cast<size_t>(config.threads));
+  BookBuilder book;
+  std::atomic<int> next_game{0};
+  std::atomic<int> finished{0};
+  std::atomic<uint64_t> searches{0};
+
+  // One opening per thread at a time; their searches share the pool, as the
+  // server's engines do. Engines keep their tables across openings, which
+  // share most of their positions.
+  std::vector<std::thread> workers;
+  for (int t = 0; t < config.threads; ++t) {
+    workers.emplace_back([&] {
+      othello::Engine engine(evaluator, thread_pool,
+                             static_cast<size_t>(config.tt_size_mb));
+      engine.setVerbose(false);
+      for (int game; (game = next_game.fetch_add(1)) < config.games;) {
+        playOpening(engine, config, config.seed + static_cast<uint64_t>(game),
+                    book, searches);
+        const int done = finished.fetch_add(1) + 1;
+        if (done % 10 == 0 || done == config.games) {
+          std::cout << "\rplayed " << done << '/' << config.games
+                    << " openings" << std::flush;
+        }
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  std::vector<othello::BookEntry> entries = book.take();
+  const size_t positions = entries.size();
+  othello::OpeningBook::save(config.output, std::move(entries));
+  std::cout << "\rwrote " << positions << " positions to " << config.output
+            << " from " << config.games << " openings (" << searches.load()
+            << " searches at depth " << config.depth << ") in " << std::fixed
+            << std::setprecision(1) << secondsSince(start) << " s"
+            << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    const Config config = parseArgs(argc, argv);
+    othello::initializeZobrist();
+
+    if (config.weights_file.empty()) {
+      othello::MobilityEvaluator evaluator;
+      buildBook(config, evaluator);
+    } else {
+      othello::PatternEvaluator evaluator(config.weights_file);
+      buildBook(config, evaluator);
+    }
+  } catch (const std::exception &error) {
+    std::cerr << "book error: " << error.what() << '\n';
+    std::cerr << "Run with --help for usage.\n";
+    return 1;
+  }
+  return 0;
+}
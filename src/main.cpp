@@ -16,6 +16,8 @@ namespace {
 struct EngineOptions {
   int depth = 15;
   int time_limit_ms = 2000;
+  int clock_ms = 0;  // Game clock per side; 0 uses time_limit_ms per move
+  int increment_ms = 0;
 };
 
 bool parseInt(std::string_view value, int &result) {
@@ -48,6 +50,24 @@ bool parseOptions(int argc, char **argv, EngineOptions &options) {
     return false;
   }
 
+  if (argc <= 3) {
+    return true;
+  }
+
+  if (!parseInt(argv[3], options.clock_ms) || options.clock_ms <= 0) {
+    std::cerr << "Invalid game clock. Must be greater than 0." << std::endl;
+    return false;
+  }
+
+  if (argc <= 4) {
+    return true;
+  }
+
+  if (!parseInt(argv[4], options.increment_ms) || options.increment_ms < 0) {
+    std::cerr << "Invalid increment. Must not be negative." << std::endl;
+    return false;
+  }
+
   return true;
 }
 
@@ -59,9 +79,14 @@ int main(int argc, char **argv) {
     return 1;
   }
 
-  std::cout << "Using depth: " << options.depth
-            << " and time limit: " << options.time_limit_ms << " ms"
-            << std::endl;
+  std::cout << "Using depth: " << options.depth;
+  if (options.clock_ms > 0) {
+    std::cout << " and game clock: " << options.clock_ms << " ms + "
+              << options.increment_ms << " ms per move" << std::endl;
+  } else {
+    std::cout << " and time limit: " << options.time_limit_ms << " ms"
+              << std::endl;
+  }
   othello::initializeZobrist();
   othello::MobilityEvaluator evaluator;  // Create the mobility evaluator
   utils::profiler::start("cpu_single_thread.prof");
@@ -69,6 +94,12 @@ int main(int argc, char **argv) {
   utils::ThreadPool thread_pool(4); // Create a thread pool
   othello::Engine engine(evaluator, thread_pool);  // Create the engine with the evaluator
   othello::Controller controller(engine); // Create the controller with the evaluator
-  controller.startGame(options.depth, options.time_limit_ms);  // Start the game loop
+  if (options.clock_ms > 0) {
+    controller.startGame(options.depth,
+                         othello::GameClock{options.clock_ms,
+                                            options.increment_ms});
+  } else {
+    controller.startGame(options.depth, options.time_limit_ms);  // Start the game loop
+  }
   return 0;                // Exit the program
 }
@@ -0,0 +1,219 @@
+// Copyright (c) 2026 Alex Li
+// movegen_bench.cpp
+// Micro-benchmark timing every move generation kernel on a fixed corpus,
+// and the flip kernels against the reference loop
+
+#include <bit>
+#include <chrono>
+#include <cstdint>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "othello/GameBoard.hpp"
+#include "othello/MoveGen.hpp"
+#include "othello/OthelloRules.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+
+struct Config {
+  int positions = 10000;
+  int iterations = 200;
+  uint64_t seed = 1738;
+};
+
+/// A position from the side to move's point of view
+struct Position {
+  uint64_t player;
+  uint64_t opponent;
+};
+
+/// A legal move in a corpus position
+struct Move {
+  uint64_t player;
+  uint64_t opponent;
+  int square;
+};
+
+void printUsage(const char *program) {
+  std::cout << "Usage: " << program << " [options]\n"
+            << "\n"
+            << "  --positions N   Positions in the corpus\n"
+            << "  --iterations N  Passes over the corpus per kernel\n"
+            << "  --seed N        Seed of the random games the corpus is\n"
+            << "                  drawn from\n"
+            << "  --help          Show this help\n";
+}
+
+int parsePositiveInt(const std::string &value, const std::string &name) {
+  size_t parsed = 0;
+  const int result = std::stoi(value, &parsed);
+  if (parsed != value.size() || result <= 0) {
+    throw std::invalid_argument(name + " must be a positive integer");
+  }
+  return result;
+}
+
+Config parseArgs(int argc, char **argv) {
+  Config config;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    auto requireValue = [&](const std::string &name) -> std::string {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument(name + " requires a value");
+      }
+      return argv[++i];
+    };
+
+    if (arg == "--help" || arg == "-h") {
+      printUsage(argv[0]);
+      std::exit(0);
+    } else if (arg == "--positions") {
+      config.positions = parsePositiveInt(requireValue(arg), "positions");
+    } else if (arg == "--iterations") {
+      config.iterations = parsePositiveInt(requireValue(arg), "iterations");
+    } else if (arg == "--seed") {
+      config.seed = std::stoull(requireValue(arg));
+    } else {
+      throw std::invalid_argument("unknown option: " + arg);
+    }
+  }
+  return config;
+}
+
+/// @brief Collect every position of random games until the corpus is full
+/// @details Games give the mix of densities and move counts a search sees,
+///          and the fixed seed keeps the corpus identical across runs.
+std::vector<Position> buildCorpus(const Config &config) {
+  std::mt19937_64 rng(config.seed);
+  std::vector<Position> corpus;
+  corpus.reserve(config.positions);
+  while (static_cast<int>(corpus.size()) < config.positions) {
+    othello::GameBoard board = othello::createInitialBoard();
+    while (static_cast<int>(corpus.size()) < config.positions) {
+      const othello::Color color = board.current_turn;
+      uint64_t moves = othello::getPossibleMoves(board, color);
+      if (!moves) {
+        break;
+      }
+      corpus.push_back(color == othello::Color::BLACK
+                           ? Position{board.black_bb, board.white_bb}
+                           : Position{board.white_bb, board.black_bb});
+      for (int pick = static_cast<int>(rng() % std::popcount(moves)); pick > 0;
+           --pick) {
+        moves &= moves - 1;
+      }
+      board = othello::applyMove(board, std::countr_zero(moves), color);
+    }
+  }
+  return corpus;
+}
+
+std::vector<Move> legalMoves(const std::vector<Position> &corpus) {
+  const othello::MoveGenKernels &scalar =
+      *othello::moveGenKernels(othello::SimdLevel::SCALAR);
+  std::vector<Move> moves;
+  for (const Position &position : corpus) {
+    for (uint64_t legal = scalar.moves(position.player, position.opponent);
+         legal; legal &= legal - 1) {
+      moves.push_back(
+          {position.player, position.opponent, std::countr_zero(legal)});
+    }
+  }
+  return moves;
+}
+
+/// @brief Time repeated passes of fn over items
+/// @return Nanoseconds per item, with the checksum of the last pass
+template <typename Item, typename Fn>
+double timePasses(const std::vector<Item> &items, int iterations, Fn fn,
+                  uint64_t &checksum) {
+  const auto start = Clock::now();
+  for (int i = 0; i < iterations; ++i) {
+    checksum = 0;
+    for (const Item &item : items) {
+      checksum = std::rotl(checksum, 1) ^ fn(item);
+    }
+  }
+  const std::chrono::duration<double, std::nano> elapsed = Clock::now() - start;
+  return elapsed.count() / (static_cast<double>(items.size()) * iterations);
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    const Config config = parseArgs(argc, argv);
+    const std::vector<Position> corpus = buildCorpus(config);
+    const std::vector<Move> moves = legalMoves(corpus);
+
+    std::cout << "Corpus: " << corpus.size() << " positions, " << moves.size()
+              << " legal moves, seed " << config.seed << '\n'
+              << "Detected: "
+              << othello::simdLevelName(othello::detectSimdLevel())
+              << ", active: "
+              << othello::simdLevelName(othello::activeMoveGen().level)
+              << "\n\n";
+    std::cout << std::left << std::setw(10) << "kernel" << std::right
+              << std::setw(12) << "moves ns" << std::setw(12) << "flips ns"
+              << std::setw(12) << "Mflips/s" << std::setw(20)
+              << "moves checksum" << std::setw(20) << "flips checksum" << '\n';
+
+    // The square-by-square loop, for comparison with the flip kernels
+    uint64_t reference_checksum = 0;
+    const double reference_ns = timePasses(
+        moves, config.iterations,
+        [](const Move &m) {
+          return othello::referenceFlips(m.player, m.opponent, m.square);
+        },
+        reference_checksum);
+    std::cout << std::left << std::setw(10) << "reference" << std::right
+              << std::setw(12) << "-" << std::fixed << std::setprecision(2)
+              << std::setw(12) << reference_ns << std::setw(12)
+              << 1000.0 / reference_ns << std::setw(20) << "-" << std::hex
+              << std::setw(20) << reference_checksum << std::dec << '\n';
+
+    for (othello::SimdLevel level :
+         {othello::SimdLevel::SCALAR, othello::SimdLevel::AVX2,
+          othello::SimdLevel::AVX512}) {
+      const othello::MoveGenKernels *kernels = othello::moveGenKernels(level);
+      std::cout << std::left << std::setw(10) << othello::simdLevelName(level)
+                << std::right;
+      if (kernels == nullptr) {
+        std::cout << std::setw(12) << "-" << std::setw(12) << "-"
+                  << std::setw(12) << "-" << "  (unsupported)\n";
+        continue;
+      }
+      uint64_t moves_checksum = 0;
+      uint64_t flips_checksum = 0;
+      const double moves_ns = timePasses(
+          corpus, config.iterations,
+          [kernels](const Position &p) {
+            return kernels->moves(p.player, p.opponent);
+          },
+          moves_checksum);
+      const double flips_ns = timePasses(
+          moves, config.iterations,
+          [kernels](const Move &m) {
+            return kernels->flips(m.player, m.opponent, m.square);
+          },
+          flips_checksum);
+      std::cout << std::fixed << std::setprecision(2) << std::setw(12)
+                << moves_ns << std::setw(12) << flips_ns << std::setw(12)
+                << 1000.0 / flips_ns << std::hex
+                << std::setw(20) << moves_checksum << std::setw(20)
+                << flips_checksum << std::dec << '\n';
+    }
+  } catch (const std::exception &error) {
+    std::cerr << "movegen_bench error: " << error.what() << '\n';
+    std::cerr << "Run with --help for usage.\n";
+    return 1;
+  }
+  return 0;
+}
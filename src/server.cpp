@@ -2,23 +2,140 @@
 // Simple gRPC server entry point for the Othello engine.
 
 #include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cstdlib>
+#include <exception>
+#include <functional>
 #include <iostream>
+#include <limits>
 #include <memory>
+#include <optional>
 #include <string>
+#include <thread>
+#include <utility>
 
 #include <grpcpp/grpcpp.h>
 
 #include "engine.grpc.pb.h"
+#include "othello/BatchSearcher.hpp"
 #include "othello/Engine.hpp"
+#include "othello/EnginePool.hpp"
 #include "othello/GameBoard.hpp"
+#include "othello/OpeningBook.hpp"
+#include "othello/ResultCache.hpp"
+#include "othello/TimeManager.hpp"
 #include "othello/evaluator/Evaluator.hpp"
+#include "othello/evaluator/PatternEvaluator.hpp"
 
 namespace {
 
 constexpr uint8_t kDefaultDepthLimit = 8;
 constexpr int kDefaultTimeLimitMs = 1000;
-constexpr int kSearchThreads = 4;
+constexpr size_t kDefaultConcurrentSearches = 2;
+constexpr size_t kDefaultQueuedSearches = 16;
+constexpr size_t kDefaultResultCacheMB = 16;
+
+/// Result cache counters are logged after every this many requests
+constexpr uint64_t kCacheReportInterval = 1000;
+
+/// Time kept back from a call's deadline to send the response
+constexpr int64_t kDeadlineMarginMs = 10;
+
+/// @brief Read a non-negative size from the environment
+size_t envSize(const char *name, size_t default_value) {
+  const char *value = std::getenv(name);
+  if (value == nullptr || std::string(value).empty()) {
+    return default_value;
+  }
+  return static_cast<size_t>(std::max(0, std::atoi(value)));
+}
+
+size_t searchThreads() {
+  const size_t hardware = std::max(1u, std::thread::hardware_concurrency());
+  return std::max<size_t>(1, envSize("OTHELLO_SEARCH_THREADS", hardware));
+}
+
+othello::SearchMode searchMode() {
+  const char *mode = std::getenv("OTHELLO_SEARCH_MODE");
+  if (mode == nullptr || std::string(mode).empty()) {
+    return othello::SearchMode::YBWC;
+  }
+  const auto parsed = othello::parseSearchMode(mode);
+  if (!parsed) {
+    std::cerr << "Unknown OTHELLO_SEARCH_MODE '" << mode
+              << "', using ybwc" << std::endl;
+    return othello::SearchMode::YBWC;
+  }
+  return *parsed;
+}
+
+othello::SearchDriver searchDriver() {
+  const char *driver = std::getenv("OTHELLO_SEARCH_DRIVER");
+  if (driver == nullptr || std::string(driver).empty()) {
+    return othello::SearchDriver::ASPIRATION;
+  }
+  const auto parsed = othello::parseSearchDriver(driver);
+  if (!parsed) {
+    std::cerr << "Unknown OTHELLO_SEARCH_DRIVER '" << driver
+              << "', using aspiration" << std::endl;
+    return othello::SearchDriver::ASPIRATION;
+  }
+  return *parsed;
+}
+
+/// @brief The pattern evaluator when OTHELLO_EVAL_WEIGHTS names a weights
+///        file, otherwise the mobility evaluator
+std::unique_ptr<othello::Evaluator> makeEvaluator() {
+  const char *weights = std::getenv("OTHELLO_EVAL_WEIGHTS");
+  if (weights != nullptr && !std::string(weights).empty()) {
+    try {
+      return std::make_unique<othello::PatternEvaluator>(weights);
+    } catch (const std::exception &error) {
+      std::cerr << error.what() << ", using the mobility evaluator"
+                << std::endl;
+    }
+  }
+  return std::make_unique<othello::MobilityEvaluator>();
+}
+
+/// @brief The book named by OTHELLO_OPENING_BOOK, or nullptr if unset or
+///        unreadable
+std::unique_ptr<othello::OpeningBook> makeOpeningBook() {
+  const char *path = std::getenv("OTHELLO_OPENING_BOOK");
+  if (path != nullptr && !std::string(path).empty()) {
+    try {
+      auto book = std::make_unique<othello::OpeningBook>(path);
+      std::cout << "Opening book " << path << ": " << book->size()
+                << " positions" << std::endl;
+      return book;
+    } catch (const std::exception &error) {
+      std::cerr << error.what() << ", searching every position"
+                << std::endl;
+    }
+  }
+  return nullptr;
+}
+
+othello::EnginePoolOptions enginePoolOptions(
+    const othello::OpeningBook *opening_book) {
+  return othello::EnginePoolOptions{
+      .engines = std::max<size_t>(
+          1, envSize("OTHELLO_MAX_CONCURRENT_SEARCHES",
+                     kDefaultConcurrentSearches)),
+      .max_queue =
+          envSize("OTHELLO_MAX_QUEUED_SEARCHES", kDefaultQueuedSearches),
+      .tt_size_mb =
+          std::max<size_t>(1, envSize("OTHELLO_TT_MB", othello::kDefaultTTSizeMB)),
+      .search_mode = searchMode(),
+      .search_driver = searchDriver(),
+      .endgame_empties = static_cast<int>(std::min<size_t>(
+          60, envSize("OTHELLO_ENDGAME_EMPTIES",
+                      othello::kDefaultEndgameEmpties))),
+      .opening_book = opening_book,
+  };
+}
 
 std::string serverAddress() {
   const char *address = std::getenv("OTHELLO_SERVER_ADDRESS");
@@ -28,19 +145,108 @@ std::string serverAddress() {
   return address;
 }
 
-uint8_t depthLimit(const engine::FindBestMoveRequest &request) {
-  const uint32_t requested = request.depth_limit();
+/// @brief A request's depth limit, or the default if it has none
+uint8_t depthLimit(uint32_t requested) {
   if (requested == 0) {
     return kDefaultDepthLimit;
   }
   return static_cast<uint8_t>(std::min<uint32_t>(requested, 60));
 }
 
-int timeLimitMs(const engine::FindBestMoveRequest &request) {
-  if (request.time_limit_ms() == 0) {
+/// @brief A request's time limit, or the default if it has none
+int timeLimitMs(uint32_t requested) {
+  if (requested == 0) {
     return kDefaultTimeLimitMs;
   }
-  return static_cast<int>(request.time_limit_ms());
+  return static_cast<int>(
+      std::min<uint32_t>(requested, std::numeric_limits<int>::max()));
+}
+
+/// @brief The board and side to move of a request's game state
+std::pair<othello::GameBoard, othello::Color> position(
+    const engine::GameState &state) {
+  const othello::Color color = state.black_to_move() ? othello::Color::BLACK
+                                                     : othello::Color::WHITE;
+  return {othello::GameBoard(
+              state.black_bb(), state.white_bb(),
+              othello::zobristHash(state.black_bb(), state.white_bb(), color),
+              color),
+          color};
+}
+
+/// @brief A search score for color as reported to clients: positive if black
+///        is ahead
+int blackScore(int score, othello::Color color) {
+  return score * static_cast<int>(color);
+}
+
+/// @brief This move's budget: allocated from the game clock when the request
+///        has one, otherwise the flat time limit
+othello::MoveBudget moveBudget(const engine::FindBestMoveRequest &request,
+                               const othello::GameBoard &board) {
+  if (request.remaining_time_ms() == 0) {
+    const int time_limit_ms = timeLimitMs(request.time_limit_ms());
+    return {time_limit_ms, time_limit_ms};
+  }
+  constexpr uint32_t kMaxMs = std::numeric_limits<int>::max();
+  const othello::GameClock clock{
+      .remaining_ms =
+          static_cast<int>(std::min(request.remaining_time_ms(), kMaxMs)),
+      .increment_ms = static_cast<int>(std::min(request.increment_ms(), kMaxMs)),
+  };
+  return othello::TimeManager::allocate(
+      clock, 64 - std::popcount(board.black_bb | board.white_bb));
+}
+
+/// @brief Milliseconds a search may take and still answer before the
+///        call's deadline; effectively unlimited without a deadline
+int msUntilDeadline(const grpc::ServerContext &context) {
+  const int64_t remaining =
+      std::chrono::duration_cast<std::chrono::milliseconds>(
+          context.deadline() - std::chrono::system_clock::now())
+          .count() -
+      kDeadlineMarginMs;
+  return static_cast<int>(std::clamp<int64_t>(
+      remaining, 0, std::numeric_limits<int>::max()));
+}
+
+/// @brief How long a call may wait for a search to be run for it: until
+///        msUntilDeadline() runs out or the client cancels
+othello::WaitLimit waitLimit(grpc::ServerContext &context) {
+  return {
+      .deadline = std::chrono::steady_clock::now() +
+                  std::chrono::milliseconds(msUntilDeadline(context)),
+      .stop = [&context] { return context.IsCancelled(); },
+  };
+}
+
+/// @brief Status for a call the engine pool did not admit
+grpc::Status refusal(const grpc::ServerContext &context,
+                     const othello::WaitLimit &limit) {
+  if (context.IsCancelled()) {
+    return grpc::Status(grpc::StatusCode::CANCELLED, "request cancelled");
+  }
+  if (std::chrono::steady_clock::now() >= limit.deadline) {
+    return grpc::Status(grpc::StatusCode::DEADLINE_EXCEEDED,
+                        "deadline passed waiting for an engine");
+  }
+  return grpc::Status(grpc::StatusCode::RESOURCE_EXHAUSTED,
+                      "search queue is full; retry later");
+}
+
+/// @brief Name of a cache outcome, as sent in the othello-cache trailer
+const char *cacheOutcomeName(othello::ResultCache::Outcome outcome) {
+  switch (outcome) {
+  case othello::ResultCache::Outcome::HIT:
+    return "hit";
+  case othello::ResultCache::Outcome::COALESCED:
+    return "coalesced";
+  case othello::ResultCache::Outcome::GAVE_UP:
+    return "gave-up";
+  case othello::ResultCache::Outcome::MISS:
+    break;
+  }
+  return "miss";
 }
 
 class EngineService final : public engine::EngineService::Service {
@@ -48,38 +254,320 @@ class EngineService final : public engine::EngineService::Service {
   grpc::Status FindBestMove(grpc::ServerContext *context,
                             const engine::FindBestMoveRequest *request,
                             engine::FindBestMoveResponse *response) override {
-    (void)context;
+    const auto [board, color] = position(request->game_state());
+    const uint8_t depth = depthLimit(request->depth_limit());
+    const othello::MoveBudget budget = moveBudget(*request, board);
+    // Repeated positions are answered from the cache, and identical requests
+    // in flight share one search. Each search leases its own engine, so
+    // search state and statistics are never shared between concurrent calls.
+    // Waits for another request's search or for an engine end at the call's
+    // deadline or cancellation.
+    const othello::WaitLimit limit = waitLimit(*context);
+    othello::ResultCache::Outcome outcome;
+    const std::optional<othello::CachedSearch> result = cache_.lookup(
+        board, color, depth, budget.hard_ms,
+        [&]() -> std::optional<othello::CachedSearch> {
+          std::optional<othello::EnginePool::Lease> engine =
+              engines_.acquire(limit.deadline, limit.stop);
+          if (!engine) {
+            return std::nullopt;
+          }
+          // The search ends in time for the call's deadline, measured after
+          // any wait for the engine, and as soon as the client cancels. It
+          // never starts an iteration predicted to overrun the budget.
+          const int hard_ms =
+              std::min(budget.hard_ms, msUntilDeadline(*context));
+          othello::TimeManager time(
+              {std::min(budget.soft_ms, hard_ms), hard_ms});
+          const int best_move = (*engine)->findBestMove(
+              board, depth, color, time,
+              [context] { return context->IsCancelled(); });
+          const othello::SearchStats stats = (*engine)->lastSearchStats();
+          // Results cut shorter than the request asked for aren't reused
+          const bool cut_short =
+              stats.stopped ||
+              (stats.time_limit_hit && hard_ms < budget.hard_ms);
+          return othello::CachedSearch{
+              .best_move = best_move,
+              .eval_score = evaluationAfterMove(board, best_move, color),
+              .search_score = searchScore(color, best_move, stats),
+              .solved = best_move >= 0 && stats.solved,
+              .cacheable = !cut_short,
+          };
+        },
+        &outcome, limit);
+    context->AddTrailingMetadata("othello-cache", cacheOutcomeName(outcome));
+    reportCache();
+    if (context->IsCancelled()) {
+      return grpc::Status(grpc::StatusCode::CANCELLED, "request cancelled");
+    }
+    if (outcome == othello::ResultCache::Outcome::GAVE_UP) {
+      return grpc::Status(grpc::StatusCode::DEADLINE_EXCEEDED,
+                          "deadline passed waiting for an identical search");
+    }
+    if (!result) {
+      return refusal(*context, limit);
+    }
 
-    const othello::Color color = request->game_state().black_to_move()
-                                     ? othello::Color::BLACK
-                                     : othello::Color::WHITE;
-    const auto board = othello::GameBoard(
-        request->game_state().black_bb(), request->game_state().white_bb(),
-        othello::zobristHash(request->game_state().black_bb(),
-                             request->game_state().white_bb(), color),
-        color);
+    response->set_best_move(result->best_move);
+    response->set_eval_score(result->eval_score);
+    response->set_search_score(result->search_score);
+    response->set_solved(result->solved);
+    return grpc::Status::OK;
+  }
+
+  grpc::Status FindBestMovesBatch(
+      grpc::ServerContext *context,
+      const engine::FindBestMovesBatchRequest *request,
+      grpc::ServerWriter<engine::BatchMoveResult> *writer) override {
+    const uint8_t depth = depthLimit(request->depth_limit());
+    const int time_limit_ms = timeLimitMs(request->time_limit_ms());
+    return runBatch(
+        context,
+        [&](othello::BatchSearcher &batch) {
+          for (const engine::GameState &state : request->game_states()) {
+            const auto [board, color] = position(state);
+            batch.submit(board, color, depth, time_limit_ms);
+          }
+        },
+        [writer](const engine::BatchMoveResult &result) {
+          return writer->Write(result);
+        });
+  }
+
+  grpc::Status FindBestMovesStream(
+      grpc::ServerContext *context,
+      grpc::ServerReaderWriter<engine::BatchMoveResult,
+                               engine::FindBestMoveRequest> *stream) override {
+    return runBatch(
+        context,
+        [stream](othello::BatchSearcher &batch) {
+          engine::FindBestMoveRequest request;
+          while (stream->Read(&request)) {
+            const auto [board, color] = position(request.game_state());
+            batch.submit(board, color, depthLimit(request.depth_limit()),
+                         timeLimitMs(request.time_limit_ms()));
+          }
+        },
+        [stream](const engine::BatchMoveResult &result) {
+          return stream->Write(result);
+        });
+  }
 
+  grpc::Status AnalyzePosition(
+      grpc::ServerContext *context,
+      const engine::AnalyzePositionRequest *request,
+      grpc::ServerWriter<engine::AnalysisUpdate> *writer) override {
+    const auto [board, color] = position(request->game_state());
+    const uint8_t depth = depthLimit(request->depth_limit());
+    // Analysis wants every depth as it completes, so it skips the cache
+    const othello::WaitLimit limit = waitLimit(*context);
+    std::optional<othello::EnginePool::Lease> engine =
+        engines_.acquire(limit.deadline, limit.stop);
+    if (!engine) {
+      return refusal(*context, limit);
+    }
+    const int hard_ms = std::min(timeLimitMs(request->time_limit_ms()),
+                                 msUntilDeadline(*context));
+    othello::TimeManager time({hard_ms, hard_ms}, false);
+    const auto start = std::chrono::steady_clock::now();
+
+    // A client that stops reading, or cancels, stops the search
+    std::atomic<bool> closed{false};
+    int last_sent_move = -1;
+    auto send = [&](const engine::AnalysisUpdate &update) {
+      last_sent_move = update.best_move();
+      if (!writer->Write(update)) {
+        closed.store(true, std::memory_order_relaxed);
+      }
+    };
+    const othello::StopCondition stop = [&closed, context] {
+      return closed.load(std::memory_order_relaxed) || context->IsCancelled();
+    };
+    const othello::IterationCallback on_iteration =
+        [&](const othello::IterationReport &report) {
+          send(analysisUpdate(report, color));
+        };
+    auto finished = [&] {
+      return closed.load() || context->IsCancelled()
+                 ? grpc::Status(grpc::StatusCode::CANCELLED,
+                                "analysis cancelled")
+                 : grpc::Status::OK;
+    };
+
+    if (request->lines() > 0) {
+      // Every iteration, solves included, is reported with its lines
+      (*engine)->analyzeRootMoves(board, depth, color, request->lines(), time,
+                                  stop, on_iteration);
+      return finished();
+    }
     const int best_move =
-        engine_.findBestMove(board, depthLimit(*request), color,
-                             timeLimitMs(*request));
+        (*engine)->findBestMove(board, depth, color, time, stop, on_iteration);
+    if (!finished().ok()) {
+      return finished();
+    }
 
-    response->set_best_move(best_move);
-    response->set_eval_score(evaluationAfterMove(board, best_move, color));
+    // Book moves, exact solves and moves from an interrupted iteration
+    // aren't covered by an iteration report
+    const othello::SearchStats stats = (*engine)->lastSearchStats();
+    if (best_move >= 0 && (best_move != last_sent_move || stats.solved)) {
+      engine::AnalysisUpdate update = analysisUpdate(
+          othello::IterationReport{
+              .depth = stats.completed_depth,
+              .best_move = best_move,
+              .score = stats.score,
+              .principal_variation = {best_move},
+              .nodes_searched = stats.nodes_searched,
+              .cache_hits = static_cast<uint64_t>(stats.cache_hits),
+              .elapsed_ms = std::chrono::duration<double, std::milli>(
+                                std::chrono::steady_clock::now() - start)
+                                .count(),
+              .solved = stats.solved,
+              .lines = {},
+          },
+          color);
+      update.set_book(stats.book_hit);
+      send(update);
+    }
     return grpc::Status::OK;
   }
 
  private:
+  /// @brief Log the cache counters every kCacheReportInterval requests
+  void reportCache() {
+    if (++requests_ % kCacheReportInterval != 0) {
+      return;
+    }
+    const othello::ResultCache::Stats stats = cache_.stats();
+    std::cout << "Result cache: " << stats.hits << " hits, " << stats.misses
+              << " misses, " << stats.coalesced << " coalesced, "
+              << stats.evictions << " evictions, " << stats.entries << '/'
+              << stats.capacity << " entries" << std::endl;
+  }
+
   int evaluationAfterMove(const othello::GameBoard &board, int best_move,
                           othello::Color color) const {
     if (best_move < 0) {
-      return evaluator_.evaluate(board);
+      return evaluator_->evaluate(board);
+    }
+    return evaluator_->evaluate(othello::applyMove(board, best_move, color));
+  }
+
+  /// @brief The search's score sent with a best move, positive if black is
+  ///        ahead, or 0 if there was no move to search
+  static int searchScore(othello::Color color, int best_move,
+                         const othello::SearchStats &stats) {
+    return best_move < 0 ? 0 : blackScore(stats.score, color);
+  }
+
+  /// @brief Search a batch of positions, streaming results as they finish
+  /// @param submit Submits the positions, on a thread of its own, while
+  ///        results are written
+  /// @param write Sends one result; returns false once the client is gone
+  grpc::Status runBatch(
+      grpc::ServerContext *context,
+      const std::function<void(othello::BatchSearcher &)> &submit,
+      const std::function<bool(const engine::BatchMoveResult &)> &write) {
+    // A batch counts against the concurrent searches like one request, and
+    // runs as many searches at once as that request's share of the pool
+    // threads. Its engines search with the leased engine's tables, so
+    // related positions keep them warm and the batch allocates none. No
+    // position searches past the call's deadline.
+    const othello::WaitLimit limit = waitLimit(*context);
+    std::optional<othello::EnginePool::Lease> admission =
+        engines_.acquire(limit.deadline, limit.stop);
+    if (!admission) {
+      return refusal(*context, limit);
+    }
+    othello::BatchSearcher batch(
+        *evaluator_, thread_pool_,
+        {
+            .search_driver = pool_options_.search_driver,
+            .endgame_empties = pool_options_.endgame_empties,
+            .opening_book = pool_options_.opening_book,
+            .max_parallel = std::max<size_t>(
+                1, thread_pool_.size() / std::max<size_t>(
+                                             1, pool_options_.engines)),
+            .deadline = limit.deadline,
+            .stop_condition = [context] { return context->IsCancelled(); },
+        },
+        (*admission)->transpositionTable(), (*admission)->endgameSolver());
+    std::thread submitter([&] {
+      submit(batch);
+      batch.close();
+    });
+    while (const std::optional<othello::BatchResult> result = batch.next()) {
+      engine::BatchMoveResult message;
+      message.set_index(static_cast<uint32_t>(result->index));
+      message.set_best_move(result->best_move);
+      message.set_eval_score(evaluationAfterMove(
+          result->board, result->best_move, result->color));
+      message.set_search_score(
+          searchScore(result->color, result->best_move, result->stats));
+      message.set_solved(result->best_move >= 0 && result->stats.solved);
+      message.set_nodes(result->stats.nodes_searched);
+      if (!write(message)) {
+        batch.cancel();
+      }
+    }
+    submitter.join();
+
+    const double positions_per_sec = batch.positionsPerSecond();
+    context->AddTrailingMetadata("othello-positions",
+                                 std::to_string(batch.completed()));
+    context->AddTrailingMetadata(
+        "othello-positions-per-sec",
+        std::to_string(static_cast<uint64_t>(positions_per_sec)));
+    std::cout << "Batch: " << batch.completed() << " positions, "
+              << static_cast<uint64_t>(positions_per_sec) << " positions/s"
+              << std::endl;
+    if (context->IsCancelled()) {
+      return grpc::Status(grpc::StatusCode::CANCELLED, "batch cancelled");
+    }
+    return grpc::Status::OK;
+  }
+
+  /// @brief The message reporting an iteration of a search for color
+  static engine::AnalysisUpdate analysisUpdate(
+      const othello::IterationReport &report, othello::Color color) {
+    engine::AnalysisUpdate update;
+    update.set_depth(static_cast<uint32_t>(report.depth));
+    update.set_best_move(report.best_move);
+    update.set_score(blackScore(report.score, color));
+    for (int move : report.principal_variation) {
+      update.add_principal_variation(move);
+    }
+    update.set_nodes(report.nodes_searched);
+    update.set_nodes_per_sec(
+        report.elapsed_ms > 0
+            ? static_cast<uint64_t>(report.nodes_searched * 1000.0 /
+                                    report.elapsed_ms)
+            : 0);
+    const double visits =
+        static_cast<double>(report.nodes_searched + report.cache_hits);
+    update.set_tt_hit_rate(visits > 0 ? report.cache_hits / visits : 0.0);
+    update.set_elapsed_ms(static_cast<uint32_t>(report.elapsed_ms));
+    update.set_exact(report.solved);
+    for (const othello::RootLine &line : report.lines) {
+      engine::AnalysisLine *added = update.add_lines();
+      added->set_move(line.move);
+      added->set_score(blackScore(line.score, color));
+      for (int move : line.principal_variation) {
+        added->add_principal_variation(move);
+      }
     }
-    return evaluator_.evaluate(othello::applyMove(board, best_move, color));
+    return update;
   }
 
-  othello::MobilityEvaluator evaluator_;
-  utils::ThreadPool thread_pool_{kSearchThreads};
-  othello::Engine engine_{evaluator_, thread_pool_};
+  std::unique_ptr<othello::Evaluator> evaluator_ = makeEvaluator();
+  std::unique_ptr<othello::OpeningBook> opening_book_ = makeOpeningBook();
+  utils::ThreadPool thread_pool_{searchThreads()};
+  const othello::EnginePoolOptions pool_options_ =
+      enginePoolOptions(opening_book_.get());
+  othello::EnginePool engines_{*evaluator_, thread_pool_, pool_options_};
+  othello::ResultCache cache_{
+      envSize("OTHELLO_RESULT_CACHE_MB", kDefaultResultCacheMB) << 20};
+  std::atomic<uint64_t> requests_{0};
 };
 
 }  // namespace
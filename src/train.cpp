@@ -0,0 +1,589 @@
+// Copyright (c) 2026, Alex Li
+// train.cpp
+// Offline trainer for the pattern evaluator: plays self-play games with the
+// engine, labels their positions, and fits pattern weights to the labels.
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+#include <limits>
+#include <memory>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "othello/EndgameSolver.hpp"
+#include "othello/Engine.hpp"
+#include "othello/GameBoard.hpp"
+#include "othello/OthelloRules.hpp"
+#include "othello/Symmetry.hpp"
+#include "othello/evaluator/Evaluator.hpp"
+#include "othello/evaluator/PatternEvaluator.hpp"
+#include "utils/ThreadPool.hpp"
+
+namespace {
+
+using Clock = std::chrono::steady_clock;
+using othello::PatternEvaluator;
+
+/// How midgame positions are labeled
+enum class Label {
+  Result, ///< The exact result reached from the first solved position
+  Search, ///< The score of the search that chose the move
+};
+
+struct Config {
+  int games = 2000;
+  int depth = 4;
+  int random_plies = 10;
+  int solve_empties = 12;
+  Label label = Label::Result;
+  int epochs = 200;
+  double learning_rate = 1.0;
+  double validation = 0.1;
+  int threads = static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+  int tt_size_mb = 16;
+  uint64_t seed = 1738;
+  std::string output = "weights.bin";
+  std::string weights_file; // Starting weights; also evaluates self-play
+  std::string load_data;
+  std::string save_data;
+};
+
+/// A labeled position, from the side to move's perspective
+struct Sample {
+  uint64_t player;
+  uint64_t opponent;
+  int32_t score; ///< Engine units, 100 per disc
+};
+
+/// Magic number at the start of a saved sample file
+constexpr uint64_t kDataMagic = 0x3144505448544fULL; // "OTHTPD1"
+
+/// Labels are clamped to the largest exact score
+constexpr int kMaxLabel = 100 * othello::kMaxEndgameScore;
+
+/// Added to every weight's occurrence count before normalizing its gradient,
+/// so rarely seen configurations move slowly
+constexpr double kCountSmoothing = 8.0;
+
+void printUsage(const char *program) {
+  std::cout
+      << "Usage: " << program << " [options]\n"
+      << "\n"
+      << "Self-play:\n"
+      << "  --games N              Self-play games to generate\n"
+      << "  --depth N              Search depth for self-play moves\n"
+      << "  --random-plies N       Uniformly random opening plies per game\n"
+      << "  --solve-empties N      Solve exactly at or below N empties\n"
+      << "  --label result|search  Label midgame positions with the solved\n"
+      << "                         result of the game or with the search score\n"
+      << "  --tt-mb N              Transposition table size per game thread\n"
+      << "  --seed N               Deterministic opening seed\n"
+      << "  --save-data FILE       Save the labeled positions\n"
+      << "  --load-data FILE       Train on saved positions instead of playing\n"
+      << "\n"
+      << "Training:\n"
+      << "  --epochs N             Full passes over the training positions\n"
+      << "  --learning-rate X      Step size relative to the mean residual\n"
+      << "  --validation X         Fraction of positions held out\n"
+      << "  --weights FILE         Starting weights, also used in self-play\n"
+      << "  --output FILE          Where to write the trained weights\n"
+      << "  --threads N            Worker threads for both stages\n"
+      << "  --help                 Show this help\n";
+}
+
+int parseInt(const std::string &value, const std::string &name, int minimum) {
+  size_t parsed = 0;
+  const int result = std::stoi(value, &parsed);
+  if (parsed != value.size() || result < minimum) {
+    throw std::invalid_argument(name + " must be an integer >= " +
+                                std::to_string(minimum));
+  }
+  return result;
+}
+
+double parseDouble(const std::string &value, const std::string &name) {
+  size_t parsed = 0;
+  const double result = std::stod(value, &parsed);
+  if (parsed != value.size() || !(result >= 0.0)) {
+    throw std::invalid_argument(name + " must be a non-negative number");
+  }
+  return result;
+}
+
+Label parseLabel(const std::string &value) {
+  if (value == "result") {
+    return Label::Result;
+  }
+  if (value == "search") {
+    return Label::Search;
+  }
+  throw std::invalid_argument("label must be one of: result, search");
+}
+
+Config parseArgs(int argc, char **argv) {
+  Config config;
+  for (int i = 1; i < argc; ++i) {
+    const std::string arg = argv[i];
+    auto requireValue = [&](const std::string &name) -> std::string {
+      if (i + 1 >= argc) {
+        throw std::invalid_argument(name + " requires a value");
+      }
+      return argv[++i];
+    };
+
+    if (arg == "--help" || arg == "-h") {
+      printUsage(argv[0]);
+      std::exit(0);
+    } else if (arg == "--games") {
+      config.games = parseInt(requireValue(arg), "games", 1);
+    } else if (arg == "--depth") {
+      config.depth = parseInt(requireValue(arg), "depth", 1);
+    } else if (arg == "--random-plies") {
+      config.random_plies = parseInt(requireValue(arg), "random-plies", 0);
+    } else if (arg == "--solve-empties") {
+      config.solve_empties = parseInt(requireValue(arg), "solve-empties", 0);
+    } else if (arg == "--label") {
+      config.label = parseLabel(requireValue(arg));
+    } else if (arg == "--tt-mb") {
+      config.tt_size_mb = parseInt(requireValue(arg), "tt-mb", 1);
+    } else if (arg == "--seed") {
+      config.seed = std::stoull(requireValue(arg));
+    } else if (arg == "--save-data") {
+      config.save_data = requireValue(arg);
+    } else if (arg == "--load-data") {
+      config.load_data = requireValue(arg);
+    } else if (arg == "--epochs") {
+      config.epochs = parseInt(requireValue(arg), "epochs", 0);
+    } else if (arg == "--learning-rate") {
+      config.learning_rate = parseDouble(requireValue(arg), "learning-rate");
+    } else if (arg == "--validation") {
+      config.validation = parseDouble(requireValue(arg), "validation");
+      if (config.validation >= 1.0) {
+        throw std::invalid_argument("validation must be below 1");
+      }
+    } else if (arg == "--weights") {
+      config.weights_file = requireValue(arg);
+    } else if (arg == "--output") {
+      config.output = requireValue(arg);
+    } else if (arg == "--threads") {
+      config.threads = parseInt(requireValue(arg), "threads", 1);
+    } else {
+      throw std::invalid_argument("unknown option: " + arg);
+    }
+  }
+  if (config.depth > std::numeric_limits<uint8_t>::max()) {
+    throw std::invalid_argument("depth must fit in uint8_t");
+  }
+  return config;
+}
+
+double secondsSince(Clock::time_point start) {
+  return std::chrono::duration<double>(Clock::now() - start).count();
+}
+
+int clampLabel(int score) { return std::clamp(score, -kMaxLabel, kMaxLabel); }
+
+/// Final score of a finished game for black, empties going to the winner
+int finalScore(const othello::GameBoard &board) {
+  const int diff =
+      std::popcount(board.black_bb) - std::popcount(board.white_bb);
+  const int empties = 64 - std::popcount(board.black_bb | board.white_bb);
+  return 100 * (diff > 0 ? diff + empties : diff < 0 ? diff - empties : diff);
+}
+
+/// @brief Play one self-play game and append its labeled positions
+/// @details The first plies are random so games differ. From then on the
+///          engine picks every move; once few enough squares are empty its
+///          searches become exact solves, which label their own positions.
+///          Earlier positions take the first solved score (the result of
+///          perfect play from there) or their own search score.
+void playGame(othello::Engine &engine, const Config &config, uint64_t seed,
+              std::vector<Sample> &samples) {
+  struct Pending {
+    Sample sample;
+    othello::Color color;
+  };
+  std::vector<Pending> pending;
+  std::mt19937_64 rng(seed);
+  engine.newGame();
+
+  othello::GameBoard board = othello::createInitialBoard();
+  for (int ply = 0;; ++ply) {
+    const othello::Color color = board.current_turn;
+    uint64_t moves = othello::getPossibleMoves(board, color);
+    if (!moves) {
+      break; // applyMove hands the turn over on a pass, so the game is over
+    }
+    const bool black = color == othello::Color::BLACK;
+    const uint64_t player = black ? board.black_bb : board.white_bb;
+    const uint64_t opponent = black ? board.white_bb : board.black_bb;
+
+    int move;
+    if (ply < config.random_plies) {
+      for (int pick = static_cast<int>(rng() % std::popcount(moves)); pick > 0;
+           --pick) {
+        moves &= moves - 1;
+      }
+      move = std::countr_zero(moves);
+    } else {
+      move = engine.findBestMove(board, static_cast<uint8_t>(config.depth),
+                                 color, std::numeric_limits<int>::max());
+      const othello::SearchStats stats = engine.lastSearchStats();
+      const int score = clampLabel(stats.score);
+      if (stats.solved) {
+        for (Pending &entry : pending) {
+          entry.sample.score = entry.color == color ? score : -score;
+          samples.push_back(entry.sample);
+        }
+        pending.clear();
+        samples.push_back({player, opponent, score});
+      } else if (config.label == Label::Search) {
+        samples.push_back({player, opponent, score});
+      } else {
+        pending.push_back({{player, opponent, 0}, color});
+      }
+    }
+    board = othello::applyMove(board, move, color);
+  }
+
+  // Without a solve the played-out result labels the remaining positions
+  const int black_score = finalScore(board);
+  for (Pending &entry : pending) {
+    entry.sample.score =
+        entry.color == othello::Color::BLACK ? black_score : -black_score;
+    samples.push_back(entry.sample);
+  }
+}
+
+std::vector<Sample> generateSamples(const Config &config,
+                                    const othello::Evaluator &evaluator) {
+  const auto start = Clock::now();
+  utils::ThreadPool thread_pool(static_cast<size_t>(config.threads));
+  std::vector<std::vector<Sample>> thread_samples(config.threads);
+  std::atomic<int> next_game{0};
+  std::atomic<int> finished{0};
+
+  // One game per thread at a time; their searches share the pool, as the
+  // server's engines do
+  std::vector<std::thread> workers;
+  for (int t = 0; t < config.threads; ++t) {
+    workers.emplace_back([&, t] {
+      othello::Engine engine(evaluator, thread_pool,
+                             static_cast<size_t>(config.tt_size_mb));
+      engine.setVerbose(false);
+      engine.setEndgameEmpties(config.solve_empties);
+      for (int game; (game = next_game.fetch_add(1)) < config.games;) {
+        playGame(engine, config, config.seed + static_cast<uint64_t>(game),
+                 thread_samples[t]);
+        const int done = finished.fetch_add(1) + 1;
+        if (done % 100 == 0 || done == config.games) {
+          std::cout << "\rplayed " << done << '/' << config.games << " games"
+                    << std::flush;
+        }
+      }
+    });
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+
+  std::vector<Sample> samples;
+  for (const std::vector<Sample> &part : thread_samples) {
+    samples.insert(samples.end(), part.begin(), part.end());
+  }
+  const double seconds = secondsSince(start);
+  std::cout << "\rgenerated " << samples.size() << " positions from "
+            << config.games << " games in " << std::fixed
+            << std::setprecision(1) << seconds << " s ("
+            << std::setprecision(0) << samples.size() / seconds
+            << " positions/s)" << std::endl;
+  return samples;
+}
+
+void saveSamples(const std::string &path, const std::vector<Sample> &samples) {
+  std::ofstream out(path, std::ios::binary | std::ios::trunc);
+  const uint64_t count = samples.size();
+  out.write(reinterpret_cast<const char *>(&kDataMagic), sizeof(kDataMagic));
+  out.write(reinterpret_cast<const char *>(&count), sizeof(count));
+  out.write(reinterpret_cast<const char *>(samples.data()),
+            static_cast<std::streamsize>(count * sizeof(Sample)));
+  if (!out) {
+    throw std::runtime_error("cannot write " + path);
+  }
+}
+
+std::vector<Sample> loadSamples(const std::string &path) {
+  std::ifstream in(path, std::ios::binary);
+  uint64_t magic = 0;
+  uint64_t count = 0;
+  in.read(reinterpret_cast<char *>(&magic), sizeof(magic));
+  in.read(reinterpret_cast<char *>(&count), sizeof(count));
+  if (!in || magic != kDataMagic) {
+    throw std::runtime_error(path + " is not a training data file");
+  }
+  std::vector<Sample> samples(count);
+  in.read(reinterpret_cast<char *>(samples.data()),
+          static_cast<std::streamsize>(count * sizeof(Sample)));
+  if (!in) {
+    throw std::runtime_error(path + " is truncated");
+  }
+  std::cout << "loaded " << count << " positions from " << path << std::endl;
+  return samples;
+}
+
+/// @brief Run body(thread, begin, end) over [0, count) split across threads
+template <typename Body> void parallelFor(int threads, size_t count, Body body) {
+  std::vector<std::thread> workers;
+  for (int t = 0; t < threads; ++t) {
+    const size_t begin = count * t / threads;
+    const size_t end = count * (t + 1) / threads;
+    workers.emplace_back(body, t, begin, end);
+  }
+  for (std::thread &worker : workers) {
+    worker.join();
+  }
+}
+
+/// @brief Call visit(phase, features) for a sample in each of its eight
+///        orientations, so every placement of a pattern learns from all of
+///        them
+template <typename Visit> void forEachSymmetry(const Sample &sample, Visit visit) {
+  const int phase = PatternEvaluator::phase(sample.player, sample.opponent);
+  PatternEvaluator::Features features;
+  for (int symmetry = 0; symmetry < othello::kSymmetries; ++symmetry) {
+    PatternEvaluator::features(othello::transform(sample.player, symmetry),
+                               othello::transform(sample.opponent, symmetry),
+                               features);
+    visit(phase, features);
+  }
+}
+
+/// @brief Fits float weights by preconditioned full-batch gradient descent
+/// @details Each epoch accumulates every weight's residuals over all training
+///          positions in per-thread buffers, then moves the weight by its
+///          mean residual (scaled by the learning rate and shared among the
+///          instances that make up a prediction). Weights seen in only a few
+///          positions are damped by kCountSmoothing.
+class Trainer {
+ public:
+  Trainer(const Config &config, const PatternEvaluator &initial,
+          const std::vector<Sample> &training)
+      : config(config), training(training),
+        weights(kTotalWeights), counts(kTotalWeights, 0.0F),
+        gradients(config.threads, std::vector<float>(kTotalWeights)) {
+    for (int phase = 0; phase < PatternEvaluator::kPhases; ++phase) {
+      std::copy_n(initial.phaseWeights(phase), PatternEvaluator::kWeightsPerPhase,
+                  weights.begin() + phase * PatternEvaluator::kWeightsPerPhase);
+    }
+    accumulate([](const Sample &, double) { return 1.0; });
+    reduceInto(counts);
+  }
+
+  /// @brief Run one epoch
+  /// @return The training root mean square error before the update, in discs
+  double epoch() {
+    std::vector<double> squared(config.threads, 0.0);
+    accumulate([&](const Sample &sample, double prediction) {
+      return sample.score - prediction;
+    }, &squared);
+
+    std::vector<float> residuals(kTotalWeights);
+    reduceInto(residuals);
+    const double step =
+        config.learning_rate / static_cast<double>(PatternEvaluator::kInstances);
+    parallelFor(config.threads, kTotalWeights,
+                [&](int, size_t begin, size_t end) {
+                  for (size_t i = begin; i < end; ++i) {
+                    weights[i] += static_cast<float>(
+                        step * residuals[i] / (counts[i] + kCountSmoothing));
+                  }
+                });
+
+    double total = 0.0;
+    for (double value : squared) {
+      total += value;
+    }
+    return std::sqrt(total / (training.size() * othello::kSymmetries)) / 100.0;
+  }
+
+  /// @brief Root mean square error of the rounded weights, in discs
+  double error(const std::vector<Sample> &samples) const {
+    const PatternEvaluator evaluator = quantized();
+    std::vector<double> squared(config.threads, 0.0);
+    parallelFor(config.threads, samples.size(),
+                [&](int t, size_t begin, size_t end) {
+                  for (size_t i = begin; i < end; ++i) {
+                    const double residual =
+                        samples[i].score -
+                        evaluator.evaluate(samples[i].player, samples[i].opponent);
+                    squared[t] += residual * residual;
+                  }
+                });
+    double total = 0.0;
+    for (double value : squared) {
+      total += value;
+    }
+    return samples.empty() ? 0.0 : std::sqrt(total / samples.size()) / 100.0;
+  }
+
+  /// @brief The current weights rounded to the evaluator's 16-bit tables
+  PatternEvaluator quantized() const {
+    PatternEvaluator evaluator;
+    for (int phase = 0; phase < PatternEvaluator::kPhases; ++phase) {
+      int16_t *table = evaluator.phaseWeights(phase);
+      const float *source =
+          weights.data() + phase * PatternEvaluator::kWeightsPerPhase;
+      for (size_t i = 0; i < PatternEvaluator::kWeightsPerPhase; ++i) {
+        table[i] = static_cast<int16_t>(std::clamp(
+            std::lround(source[i]),
+            static_cast<long>(std::numeric_limits<int16_t>::min()),
+            static_cast<long>(std::numeric_limits<int16_t>::max())));
+      }
+    }
+    return evaluator;
+  }
+
+ private:
+  static constexpr size_t kTotalWeights =
+      PatternEvaluator::kPhases * PatternEvaluator::kWeightsPerPhase;
+
+  /// @brief Add value(sample, prediction) to every weight the sample's
+  ///        orientations use, in the calling thread's gradient buffer
+  template <typename Value>
+  void accumulate(Value value, std::vector<double> *squared = nullptr) {
+    parallelFor(config.threads, training.size(),
+                [&](int t, size_t begin, size_t end) {
+                  std::vector<float> &gradient = gradients[t];
+                  std::fill(gradient.begin(), gradient.end(), 0.0F);
+                  for (size_t i = begin; i < end; ++i) {
+                    forEachSymmetry(training[i], [&](int phase,
+                                                     const PatternEvaluator::Features &features) {
+                      const float *table =
+                          weights.data() + phase * PatternEvaluator::kWeightsPerPhase;
+                      float *slot =
+                          gradient.data() + phase * PatternEvaluator::kWeightsPerPhase;
+                      double prediction = 0.0;
+                      for (uint32_t index : features) {
+                        prediction += table[index];
+                      }
+                      const double delta = value(training[i], prediction);
+                      if (squared != nullptr) {
+                        (*squared)[t] += delta * delta;
+                      }
+                      for (uint32_t index : features) {
+                        slot[index] += static_cast<float>(delta);
+                      }
+                    });
+                  }
+                });
+  }
+
+  /// @brief Sum the per-thread buffers into out
+  void reduceInto(std::vector<float> &out) {
+    parallelFor(config.threads, kTotalWeights,
+                [&](int, size_t begin, size_t end) {
+                  for (size_t i = begin; i < end; ++i) {
+                    float sum = 0.0F;
+                    for (const std::vector<float> &gradient : gradients) {
+                      sum += gradient[i];
+                    }
+                    out[i] = sum;
+                  }
+                });
+  }
+
+  const Config &config;
+  const std::vector<Sample> &training;
+  std::vector<float> weights;
+  std::vector<float> counts;
+  std::vector<std::vector<float>> gradients;
+};
+
+void train(const Config &config, const PatternEvaluator &initial,
+           std::vector<Sample> samples) {
+  // Hold out whole games at the end of the list
+  const size_t validation_size =
+      static_cast<size_t>(samples.size() * config.validation);
+  const std::vector<Sample> validation(samples.end() - validation_size,
+                                       samples.end());
+  samples.resize(samples.size() - validation_size);
+  if (samples.empty()) {
+    throw std::runtime_error("no training positions");
+  }
+  std::cout << "training on " << samples.size() << " positions, validating on "
+            << validation.size() << std::endl;
+
+  Trainer trainer(config, initial, samples);
+  PatternEvaluator best = trainer.quantized();
+  double best_error = trainer.error(validation);
+  int best_epoch = 0;
+  const auto start = Clock::now();
+  for (int epoch = 1; epoch <= config.epochs; ++epoch) {
+    const auto epoch_start = Clock::now();
+    const double training_error = trainer.epoch();
+    const double seconds = secondsSince(epoch_start);
+    const double validation_error = trainer.error(validation);
+    if (validation.empty() || validation_error < best_error) {
+      best = trainer.quantized();
+      best_error = validation_error;
+      best_epoch = epoch;
+    }
+    std::cout << "epoch " << std::setw(4) << epoch << "  train "
+              << std::fixed << std::setprecision(3) << training_error
+              << "  validation " << validation_error << " discs  "
+              << std::setprecision(2) << seconds << " s  "
+              << std::setprecision(0)
+              << samples.size() * othello::kSymmetries / seconds
+              << " positions/s" << std::endl;
+  }
+  std::cout << "trained " << config.epochs << " epochs in " << std::fixed
+            << std::setprecision(1) << secondsSince(start) << " s; best validation "
+            << std::setprecision(3) << best_error << " discs at epoch "
+            << best_epoch << std::endl;
+
+  best.save(config.output);
+  std::cout << "wrote " << config.output << std::endl;
+}
+
+} // namespace
+
+int main(int argc, char **argv) {
+  try {
+    const Config config = parseArgs(argc, argv);
+    othello::initializeZobrist();
+
+    std::unique_ptr<PatternEvaluator> initial =
+        config.weights_file.empty()
+            ? std::make_unique<PatternEvaluator>()
+            : std::make_unique<PatternEvaluator>(config.weights_file);
+
+    std::vector<Sample> samples;
+    if (!config.load_data.empty()) {
+      samples = loadSamples(config.load_data);
+    } else if (config.weights_file.empty()) {
+      othello::MobilityEvaluator evaluator;
+      samples = generateSamples(config, evaluator);
+    } else {
+      samples = generateSamples(config, *initial);
+    }
+    if (!config.save_data.empty()) {
+      saveSamples(config.save_data, samples);
+    }
+    train(config, *initial, std::move(samples));
+  } catch (const std::exception &error) {
+    std::cerr << "train error: " << error.what() << '\n';
+    std::cerr << "Run with --help for usage.\n";
+    return 1;
+  }
+  return 0;
+}
@@ -1,46 +1,306 @@
 // Copyright (c) Alex Li, 2026
 // ThreadPool.cpp
-// Implementation of a generic thread pool class
+// Implementation of a work-stealing thread pool
 
 #include "utils/ThreadPool.hpp"
 
+#include <exception>
 #include <mutex>
+#include <utility>
 
 namespace utils {
-ThreadPool::ThreadPool(size_t num_threads) : stop(false) {
+
+namespace {
+// Pool and index of the worker running on this thread, if any
+thread_local const ThreadPool *current_pool = nullptr;
+thread_local int current_index = -1;
+
+// Number of wait() calls the calling thread is inside
+thread_local int wait_depth = 0;
+
+// Per-thread xorshift state used to pick steal victims
+thread_local uint32_t steal_seed = 0x9E3779B9u;
+
+uint32_t nextVictimSeed() {
+  steal_seed ^= steal_seed << 13;
+  steal_seed ^= steal_seed >> 17;
+  steal_seed ^= steal_seed << 5;
+  return steal_seed;
+}
+
+constexpr int kIdleSpins = 64; // Failed task searches before a thread sleeps
+} // namespace
+
+bool ThreadPool::WorkQueue::push(Task *task) {
+  const int64_t b = bottom.load(std::memory_order_relaxed);
+  const int64_t t = top.load(std::memory_order_acquire);
+  if (b - t >= kCapacity) {
+    return false;
+  }
+  buffer[b & (kCapacity - 1)].store(task, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_release);
+  bottom.store(b + 1, std::memory_order_relaxed);
+  return true;
+}
+
+Task *ThreadPool::WorkQueue::pop() {
+  const int64_t b = bottom.load(std::memory_order_relaxed) - 1;
+  bottom.store(b, std::memory_order_relaxed);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  int64_t t = top.load(std::memory_order_relaxed);
+  if (t > b) {
+    // Deque was already empty
+    bottom.store(b + 1, std::memory_order_relaxed);
+    return nullptr;
+  }
+  Task *task = buffer[b & (kCapacity - 1)].load(std::memory_order_relaxed);
+  if (t == b) {
+    // Last element: race thieves for it
+    if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                     std::memory_order_relaxed)) {
+      task = nullptr;
+    }
+    bottom.store(b + 1, std::memory_order_relaxed);
+  }
+  return task;
+}
+
+Task *ThreadPool::WorkQueue::steal() {
+  int64_t t = top.load(std::memory_order_acquire);
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  const int64_t b = bottom.load(std::memory_order_acquire);
+  if (t >= b) {
+    return nullptr;
+  }
+  Task *task = buffer[t & (kCapacity - 1)].load(std::memory_order_relaxed);
+  if (!top.compare_exchange_strong(t, t + 1, std::memory_order_seq_cst,
+                                   std::memory_order_relaxed)) {
+    return nullptr; // Lost the race to another thief or the owner
+  }
+  return task;
+}
+
+bool ThreadPool::WorkQueue::empty() const {
+  return top.load(std::memory_order_acquire) >=
+         bottom.load(std::memory_order_acquire);
+}
+
+ThreadPool::ThreadPool(size_t num_threads) {
+  queues.reserve(num_threads);
   for (size_t i = 0; i < num_threads; ++i) {
-    workers.emplace_back([this] {
-      while (true) {
-        std::function<void()> task;
-        {
-          std::unique_lock<std::mutex> lock(this->queueMutex);
-          // Wait until there is a task or the pool is stopping
-          this->condition.wait(
-              lock, [this] { return this->stop || !this->tasks.empty(); });
-          // If stopping and no tasks, exit the thread
-          if (this->stop && this->tasks.empty()) {
-            return;
-          }
-          // Get the next task from the queue
-          task = std::move(this->tasks.front());
-          this->tasks.pop();
-        }
-        // Execute the task once the lock is released
-        task();
-      }
-    });
+    queues.push_back(std::make_unique<WorkQueue>());
+  }
+  for (size_t i = 0; i < num_threads; ++i) {
+    workers.emplace_back([this, i] { workerLoop(i); });
   }
 }
 
 ThreadPool::~ThreadPool() {
   {
-    std::unique_lock<std::mutex> lock(queueMutex);
-    stop = true;
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    stop.store(true, std::memory_order_seq_cst);
+    ++wakeEpoch;
   }
-  condition.notify_all();
+  sleepCondition.notify_all();
   for (std::thread &worker : workers) {
     worker.join();
   }
 }
-} // namespace utils
 
+int ThreadPool::workerIndex() const {
+  return current_pool == this ? current_index : -1;
+}
+
+bool ThreadPool::insideWait() { return wait_depth > 0; }
+
+void ThreadPool::spawn(TaskGroup &group, Task &task) {
+  task.group = &group;
+  group.pending.fetch_add(1, std::memory_order_relaxed);
+  submit(&task);
+}
+
+void ThreadPool::wait(TaskGroup &group) {
+  const int index = workerIndex();
+  ++wait_depth;
+  int idle = 0;
+  while (!group.done()) {
+    // Help instead of blocking: run our own children first, then steal
+    if (Task *task = findTask(index)) {
+      execute(task);
+      idle = 0;
+      continue;
+    }
+    if (index >= 0 || ++idle < kIdleSpins) {
+      std::this_thread::yield();
+      continue;
+    }
+    // Outside the pool: sleep rather than spin while the workers finish.
+    // Tasks may be queued meanwhile without waking us, so look again soon.
+    idle = 0;
+    std::unique_lock<std::mutex> lock(group.mutex);
+    group.parked.fetch_add(1, std::memory_order_seq_cst);
+    if (!group.done()) {
+      group.finished.wait_for(lock, kParkInterval);
+    }
+    group.parked.fetch_sub(1, std::memory_order_relaxed);
+  }
+  --wait_depth;
+  std::exception_ptr error;
+  {
+    // Also waits for a task still notifying the group under the lock, which
+    // must not outlive the group
+    std::lock_guard<std::mutex> lock(group.mutex);
+    error = std::exchange(group.error, nullptr);
+  }
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void ThreadPool::submit(Task *task) {
+  const int index = workerIndex();
+  if (index >= 0) {
+    if (!queues[index]->push(task)) {
+      execute(task); // Deque full: run it inline
+      return;
+    }
+  } else {
+    std::lock_guard<std::mutex> lock(injectMutex);
+    if (stop.load(std::memory_order_relaxed)) {
+      // Don't allow enqueueing after stopping the pool
+      throw std::runtime_error("Enqueue on stopped ThreadPool");
+    }
+    injected.push_back(task);
+    injectedCount.fetch_add(1, std::memory_order_relaxed);
+  }
+  notifyWorker();
+}
+
+void ThreadPool::execute(Task *task) {
+  // The task is finished however it exits, so wait() never hangs on it
+  struct Finish {
+    Task *task;
+    TaskGroup *group;
+    bool heap_owned;
+    ~Finish() {
+      if (heap_owned) {
+        delete task;
+      } else if (group != nullptr) {
+        // The owner may destroy the task, and the group, as soon as the
+        // count reaches zero, so a sleeping waiter is woken under the lock
+        // that wait() takes before it returns
+        if (group->parked.load(std::memory_order_seq_cst) > 0) {
+          std::lock_guard<std::mutex> lock(group->mutex);
+          if (group->pending.fetch_sub(1, std::memory_order_acq_rel) == 1) {
+            group->finished.notify_all();
+          }
+        } else {
+          group->pending.fetch_sub(1, std::memory_order_acq_rel);
+        }
+      }
+    }
+  } finish{task, task->group, task->heap_owned};
+  try {
+    (*task)();
+  } catch (...) {
+    if (finish.group == nullptr) {
+      throw;
+    }
+    std::lock_guard<std::mutex> lock(finish.group->mutex);
+    if (!finish.group->error) {
+      finish.group->error = std::current_exception();
+    }
+  }
+}
+
+Task *ThreadPool::findTask(int index) {
+  if (index >= 0) {
+    if (Task *task = queues[index]->pop()) {
+      return task;
+    }
+  }
+  if (injectedCount.load(std::memory_order_relaxed) > 0) {
+    std::lock_guard<std::mutex> lock(injectMutex);
+    if (!injected.empty()) {
+      Task *task = injected.front();
+      injected.pop_front();
+      injectedCount.fetch_sub(1, std::memory_order_relaxed);
+      return task;
+    }
+  }
+  const size_t count = queues.size();
+  const size_t start = nextVictimSeed() % count;
+  for (size_t i = 0; i < count; ++i) {
+    const size_t victim = (start + i) % count;
+    if (static_cast<int>(victim) == index) {
+      continue;
+    }
+    if (Task *task = queues[victim]->steal()) {
+      return task;
+    }
+  }
+  return nullptr;
+}
+
+bool ThreadPool::hasWork() const {
+  if (injectedCount.load(std::memory_order_seq_cst) > 0) {
+    return true;
+  }
+  for (const auto &queue : queues) {
+    if (!queue->empty()) {
+      return true;
+    }
+  }
+  return false;
+}
+
+void ThreadPool::notifyWorker() {
+  // Pairs with the fence in workerLoop: either the sleeper sees the new task
+  // or we see the sleeper.
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (sleepers.load(std::memory_order_seq_cst) > 0) {
+    {
+      std::lock_guard<std::mutex> lock(sleepMutex);
+      ++wakeEpoch;
+    }
+    sleepCondition.notify_one();
+  }
+}
+
+void ThreadPool::workerLoop(size_t index) {
+  current_pool = this;
+  current_index = static_cast<int>(index);
+  steal_seed ^= static_cast<uint32_t>(index + 1) * 0x85EBCA6Bu;
+  int idle = 0;
+  while (true) {
+    if (Task *task = findTask(static_cast<int>(index))) {
+      execute(task);
+      idle = 0;
+      continue;
+    }
+    if (++idle < kIdleSpins) {
+      std::this_thread::yield();
+      continue;
+    }
+    idle = 0;
+
+    std::unique_lock<std::mutex> lock(sleepMutex);
+    sleepers.fetch_add(1, std::memory_order_seq_cst);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (hasWork()) {
+      sleepers.fetch_sub(1, std::memory_order_relaxed);
+      continue;
+    }
+    if (stop.load(std::memory_order_relaxed)) {
+      // Stopping and no tasks left: exit the thread
+      sleepers.fetch_sub(1, std::memory_order_relaxed);
+      return;
+    }
+    const uint64_t epoch = wakeEpoch;
+    sleepCondition.wait(lock, [this, epoch] {
+      return wakeEpoch != epoch || stop.load(std::memory_order_relaxed);
+    });
+    sleepers.fetch_sub(1, std::memory_order_relaxed);
+  }
+}
+} // namespace utils
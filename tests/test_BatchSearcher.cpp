@@ -0,0 +1,221 @@
+// Copyright (c) 2026 Alex Li
+// test_BatchSearcher.cpp
+// Test cases for batch position search
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <optional>
+#include <thread>
+#include <vector>
+
+#include "othello/BatchSearcher.hpp"
+#include "othello/GameBoard.hpp"
+#include "othello/OthelloRules.hpp"
+#include "othello/evaluator/Evaluator.hpp"
+#include "utils/ThreadPool.hpp"
+
+namespace {
+
+/// The positions of one game played by always taking the first legal move,
+/// black to move in each
+std::vector<othello::GameBoard> gamePositions(int count) {
+  std::vector<othello::GameBoard> boards;
+  othello::GameBoard board = othello::createInitialBoard();
+  othello::Color color = othello::Color::BLACK;
+  while (static_cast<int>(boards.size()) < count) {
+    const uint64_t moves = othello::getPossibleMoves(board, color);
+    if (moves == 0) {
+      break;
+    }
+    if (color == othello::Color::BLACK) {
+      boards.push_back(board);
+    }
+    board = othello::applyMove(board, std::countr_zero(moves), color);
+    color = othello::opponent(color);
+  }
+  return boards;
+}
+
+} // namespace
+
+class BatchSearcherTest : public ::testing::Test {
+ protected:
+  void SetUp() override { othello::initializeZobrist(); }
+
+  othello::MobilityEvaluator evaluator;
+  utils::ThreadPool thread_pool{3};
+  const othello::BatchOptions options{
+      .tt_size_mb = 4, .endgame_empties = 0, .stop_condition = {}};
+};
+
+TEST_F(BatchSearcherTest, AnswersEveryPositionOnce) {
+  const std::vector<othello::GameBoard> boards = gamePositions(12);
+  othello::BatchSearcher batch(evaluator, thread_pool, options);
+  for (size_t i = 0; i < boards.size(); ++i) {
+    EXPECT_EQ(batch.submit(boards[i], othello::Color::BLACK, 4, 1 << 30), i);
+  }
+  batch.close();
+
+  std::vector<bool> answered(boards.size(), false);
+  while (std::optional<othello::BatchResult> result = batch.next()) {
+    ASSERT_LT(result->index, boards.size());
+    EXPECT_FALSE(answered[result->index]);
+    answered[result->index] = true;
+    const uint64_t legal =
+        othello::getPossibleMoves(boards[result->index], othello::Color::BLACK);
+    EXPECT_TRUE((legal >> result->best_move) & 1);
+    EXPECT_EQ(result->stats.completed_depth, 4);
+  }
+  for (bool seen : answered) {
+    EXPECT_TRUE(seen);
+  }
+  EXPECT_EQ(batch.completed(), boards.size());
+  EXPECT_GT(batch.positionsPerSecond(), 0);
+}
+
+TEST_F(BatchSearcherTest, AcceptsPositionsWhileSearching) {
+  const std::vector<othello::GameBoard> boards = gamePositions(6);
+  othello::BatchSearcher batch(evaluator, thread_pool, options);
+  batch.submit(boards[0], othello::Color::BLACK, 3, 1 << 30);
+  std::optional<othello::BatchResult> first = batch.next();
+  ASSERT_TRUE(first.has_value());
+  EXPECT_EQ(first->index, 0u);
+
+  for (size_t i = 1; i < boards.size(); ++i) {
+    batch.submit(boards[i], othello::Color::BLACK, 3, 1 << 30);
+  }
+  batch.close();
+  size_t results = 1;
+  while (batch.next()) {
+    ++results;
+  }
+  EXPECT_EQ(results, boards.size());
+
+  // A position without a legal move is answered too
+  othello::BatchSearcher empty(evaluator, thread_pool, options);
+  const othello::GameBoard full(~0ULL, 0, 0, othello::Color::BLACK);
+  empty.submit(full, othello::Color::BLACK, 3, 1 << 30);
+  empty.close();
+  const std::optional<othello::BatchResult> none = empty.next();
+  ASSERT_TRUE(none.has_value());
+  EXPECT_EQ(none->best_move, -1);
+}
+
+TEST_F(BatchSearcherTest, CancelStopsTheBatch) {
+  const std::vector<othello::GameBoard> boards = gamePositions(20);
+  const auto start = std::chrono::steady_clock::now();
+  {
+    othello::BatchSearcher batch(evaluator, thread_pool, options);
+    for (const othello::GameBoard &board : boards) {
+      batch.submit(board, othello::Color::BLACK, 40, 1 << 30);
+    }
+    batch.cancel();
+    EXPECT_FALSE(batch.next().has_value());
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::seconds(5));
+}
+
+TEST_F(BatchSearcherTest, KeepsToItsShareOfThePool) {
+  const std::vector<othello::GameBoard> boards = gamePositions(10);
+  othello::BatchOptions serial = options;
+  serial.max_parallel = 1;
+  othello::BatchSearcher batch(evaluator, thread_pool, serial);
+  for (const othello::GameBoard &board : boards) {
+    batch.submit(board, othello::Color::BLACK, 3, 1 << 30);
+  }
+  batch.close();
+  // One task takes the positions in turn, so they finish in order
+  size_t expected = 0;
+  while (std::optional<othello::BatchResult> result = batch.next()) {
+    EXPECT_EQ(result->index, expected++);
+  }
+  EXPECT_EQ(expected, boards.size());
+}
+
+TEST_F(BatchSearcherTest, DeadlineCapsEveryPosition) {
+  const std::vector<othello::GameBoard> boards = gamePositions(8);
+  othello::BatchOptions limited = options;
+  limited.max_parallel = 2;
+  const auto start = std::chrono::steady_clock::now();
+  limited.deadline = start + std::chrono::milliseconds(100);
+  othello::BatchSearcher batch(evaluator, thread_pool, limited);
+  for (const othello::GameBoard &board : boards) {
+    batch.submit(board, othello::Color::BLACK, 40, 1 << 30);
+  }
+  batch.close();
+  while (std::optional<othello::BatchResult> result = batch.next()) {
+    EXPECT_TRUE(result->stats.time_limit_hit || result->stats.stopped);
+  }
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::seconds(1));
+}
+
+TEST_F(BatchSearcherTest, WaitersTakeOnePositionAtMost) {
+  utils::ThreadPool single{1};
+  // Keep the only worker busy so the batch's task stays queued
+  std::atomic<bool> blocked{false};
+  std::atomic<bool> release{false};
+  auto blocker = single.enqueue([&blocked, &release] {
+    blocked = true;
+    while (!release.load()) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  });
+  while (!blocked.load()) {
+    std::this_thread::yield();
+  }
+
+  const std::vector<othello::GameBoard> boards = gamePositions(10);
+  othello::BatchOptions one = options;
+  one.max_parallel = 1;
+  othello::BatchSearcher batch(evaluator, single, one);
+  for (const othello::GameBoard &board : boards) {
+    batch.submit(board, othello::Color::BLACK, 40, 30);
+  }
+
+  // This wait picks up the batch's task before its own; it must get back
+  // to its own after one position instead of searching all ten
+  bool ran = false;
+  utils::Task task([&ran] { ran = true; });
+  utils::TaskGroup group;
+  single.spawn(group, task);
+  const auto start = std::chrono::steady_clock::now();
+  single.wait(group);
+  EXPECT_TRUE(ran);
+  EXPECT_LT(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(150));
+
+  release = true;
+  blocker.get();
+  batch.close();
+  size_t results = 0;
+  while (batch.next()) {
+    ++results;
+  }
+  EXPECT_EQ(results, boards.size());
+}
+
+TEST_F(BatchSearcherTest, SearchesWithGivenTables) {
+  const std::vector<othello::GameBoard> boards = gamePositions(4);
+  othello::Engine owner(evaluator, thread_pool, 1);
+  owner.setVerbose(false);
+  uint64_t nodes[2] = {0, 0};
+  for (uint64_t &round_nodes : nodes) {
+    othello::BatchSearcher batch(evaluator, thread_pool, options,
+                                 owner.transpositionTable(),
+                                 owner.endgameSolver());
+    for (const othello::GameBoard &board : boards) {
+      batch.submit(board, othello::Color::BLACK, 6, 1 << 30);
+    }
+    batch.close();
+    while (std::optional<othello::BatchResult> result = batch.next()) {
+      round_nodes += result->stats.nodes_searched;
+    }
+  }
+  // The second batch finds the first one's results in the table
+  EXPECT_LT(nodes[1], nodes[0]);
+}
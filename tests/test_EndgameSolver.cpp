@@ -0,0 +1,127 @@
+// Copyright (c) 2026 Alex Li
+// test_EndgameSolver.cpp
+// Test cases for the exact endgame solver
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <bit>
+#include <random>
+#include <utility>
+#include <vector>
+
+#include "othello/EndgameSolver.hpp"
+#include "othello/Engine.hpp"
+#include "othello/GameBoard.hpp"
+#include "othello/OthelloRules.hpp"
+#include "othello/evaluator/Evaluator.hpp"
+#include "utils/ThreadPool.hpp"
+
+namespace {
+
+/// Plain minimax over every line, used as the reference result
+int bruteForce(uint64_t player, uint64_t opponent, bool passed = false) {
+  uint64_t moves = othello::getMoves(player, opponent);
+  if (!moves) {
+    if (passed) {
+      const int diff = std::popcount(player) - std::popcount(opponent);
+      const int empties = 64 - std::popcount(player | opponent);
+      return diff > 0 ? diff + empties : diff < 0 ? diff - empties : 0;
+    }
+    return -bruteForce(opponent, player, true);
+  }
+  int best = -65;
+  for (; moves; moves &= moves - 1) {
+    const int square = std::countr_zero(moves);
+    const uint64_t flips = othello::getFlips(player, opponent, square);
+    best = std::max(best, -bruteForce(opponent ^ flips,
+                                      player | flips | (1ULL << square)));
+  }
+  return best;
+}
+
+/// Random positions with the given number of empties where the side to move
+/// (returned first) has a legal move
+std::vector<std::pair<uint64_t, uint64_t>> randomEndgames(int count,
+                                                          int empties,
+                                                          uint64_t seed) {
+  std::vector<std::pair<uint64_t, uint64_t>> positions;
+  std::mt19937_64 rng(seed);
+  while (static_cast<int>(positions.size()) < count) {
+    const othello::GameBoard initial = othello::createInitialBoard();
+    uint64_t player = initial.black_bb;
+    uint64_t opponent = initial.white_bb;
+    while (64 - std::popcount(player | opponent) > empties) {
+      uint64_t moves = othello::getMoves(player, opponent);
+      if (!moves) {
+        std::swap(player, opponent);
+        moves = othello::getMoves(player, opponent);
+        if (!moves) {
+          break;
+        }
+      }
+      int pick = static_cast<int>(rng() % std::popcount(moves));
+      for (; pick > 0; --pick) {
+        moves &= moves - 1;
+      }
+      const int square = std::countr_zero(moves);
+      const uint64_t flips = othello::getFlips(player, opponent, square);
+      const uint64_t next_player = opponent ^ flips;
+      opponent = player | flips | (1ULL << square);
+      player = next_player;
+    }
+    if (64 - std::popcount(player | opponent) == empties &&
+        othello::getMoves(player, opponent) != 0) {
+      positions.emplace_back(player, opponent);
+    }
+  }
+  return positions;
+}
+
+} // namespace
+
+TEST(EndgameSolver, LastEmptiesKernelsMatchBruteForce) {
+  othello::EndgameSolver solver(1);
+  for (int empties = 1; empties <= 4; ++empties) {
+    for (const auto &[player, opponent] : randomEndgames(50, empties, 7)) {
+      uint64_t nodes = 0;
+      EXPECT_EQ(solver.solve(player, opponent, -65, 65, nodes),
+                bruteForce(player, opponent))
+          << "empties=" << empties;
+    }
+  }
+}
+
+TEST(EndgameSolver, DeepSearchMatchesBruteForce) {
+  othello::EndgameSolver solver(1);
+  for (const auto &[player, opponent] : randomEndgames(10, 10, 11)) {
+    uint64_t nodes = 0;
+    const int expected = bruteForce(player, opponent);
+    EXPECT_EQ(solver.solve(player, opponent, -65, 65, nodes), expected);
+    EXPECT_GT(nodes, 0u);
+    // Null windows around the result must bound it on the correct side
+    EXPECT_GE(solver.solve(player, opponent, expected - 1, expected, nodes),
+              expected);
+    EXPECT_LE(solver.solve(player, opponent, expected, expected + 1, nodes),
+              expected);
+  }
+}
+
+TEST(EndgameSolver, EngineReturnsMoveAchievingSolvedScore) {
+  othello::MobilityEvaluator evaluator;
+  utils::ThreadPool thread_pool(2);
+  othello::Engine engine(evaluator, thread_pool, 1);
+  engine.setVerbose(false);
+  for (const auto &[player, opponent] : randomEndgames(5, 10, 3)) {
+    const othello::GameBoard board(player, opponent, 0, othello::Color::BLACK);
+    const int move = engine.solveEndgame(board, othello::Color::BLACK);
+    const othello::SearchStats stats = engine.lastSearchStats();
+    ASSERT_TRUE(stats.solved);
+    EXPECT_EQ(stats.score, 100 * bruteForce(player, opponent));
+
+    const uint64_t flips = othello::getFlips(player, opponent, move);
+    ASSERT_NE(flips, 0u);
+    EXPECT_EQ(-bruteForce(opponent ^ flips, player | flips | (1ULL << move)),
+              stats.score / 100);
+  }
+}
@@ -0,0 +1,308 @@
+// Copyright (c) 2026 Alex Li
+// test_Engine.cpp
+// Test cases for the engine's iterative deepening drivers and stopping
+
+#include <gtest/gtest.h>
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
+#include <random>
+#include <thread>
+#include <vector>
+
+#include "othello/Engine.hpp"
+#include "othello/GameBoard.hpp"
+#include "othello/OthelloRules.hpp"
+#include "othello/TimeManager.hpp"
+#include "othello/evaluator/Evaluator.hpp"
+#include "utils/BitboardUtils.hpp"
+#include "utils/ThreadPool.hpp"
+
+namespace {
+
+/// Positions reached by random play from the initial position, black to move
+std::vector<othello::GameBoard> randomMidgames(int count, int plies,
+                                               uint64_t seed) {
+  std::vector<othello::GameBoard> boards;
+  std::mt19937_64 rng(seed);
+  while (static_cast<int>(boards.size()) < count) {
+    othello::GameBoard board = othello::createInitialBoard();
+    othello::Color color = othello::Color::BLACK;
+    for (int ply = 0; ply < plies; ++ply) {
+      const std::vector<int> moves = othello::bitboard_to_positions(
+          othello::getPossibleMoves(board, color));
+      if (moves.empty()) {
+        break;
+      }
+      board = othello::applyMove(board, moves[rng() % moves.size()], color);
+      color = othello::opponent(color);
+    }
+    if (color == othello::Color::BLACK &&
+        othello::getPossibleMoves(board, color) != 0) {
+      boards.push_back(board);
+    }
+  }
+  return boards;
+}
+
+} // namespace
+
+class EngineTest : public ::testing::Test {
+ protected:
+  void SetUp() override { othello::initializeZobrist(); }
+
+  /// Score of a fresh engine's search with the given driver
+  int searchScore(const othello::GameBoard &board,
+                  othello::SearchDriver driver, uint8_t depth) {
+    othello::Engine engine(evaluator, thread_pool, 1);
+    engine.setVerbose(false);
+    engine.setEndgameEmpties(0);
+    engine.setSearchDriver(driver);
+    engine.findBestMove(board, depth, othello::Color::BLACK, 1 << 30);
+    return engine.lastSearchStats().score;
+  }
+
+  othello::MobilityEvaluator evaluator;
+  utils::ThreadPool thread_pool{2};
+};
+
+TEST_F(EngineTest, WindowedDriversMatchFullWindowScore) {
+  for (const othello::GameBoard &board : randomMidgames(6, 16, 5)) {
+    const int expected =
+        searchScore(board, othello::SearchDriver::FULL_WINDOW, 5);
+    EXPECT_EQ(searchScore(board, othello::SearchDriver::ASPIRATION, 5),
+              expected);
+    EXPECT_EQ(searchScore(board, othello::SearchDriver::MTDF, 5), expected);
+  }
+}
+
+TEST_F(EngineTest, CanonicalKeysShareMirroredPositions) {
+  // Black's four opening moves are mirror images of each other
+  const othello::GameBoard board = othello::createInitialBoard();
+  othello::SearchStats stats[2];
+  for (int canonical = 0; canonical < 2; ++canonical) {
+    othello::Engine engine(evaluator, thread_pool, 1);
+    engine.setVerbose(false);
+    engine.setCanonicalDiscs(canonical ? othello::kDefaultCanonicalDiscs : 0);
+    engine.findBestMove(board, 8, othello::Color::BLACK, 1 << 30);
+    stats[canonical] = engine.lastSearchStats();
+  }
+  EXPECT_EQ(stats[1].score, stats[0].score);
+  // The three later opening moves are mostly transposition table hits
+  EXPECT_LT(4 * stats[1].nodes_searched, 3 * stats[0].nodes_searched);
+}
+
+TEST_F(EngineTest, TimeLimitStopsInsideAnIteration) {
+  const othello::GameBoard board = randomMidgames(1, 12, 7)[0];
+  const uint64_t legal = othello::getPossibleMoves(board, othello::Color::BLACK);
+  for (const othello::SearchMode mode :
+       {othello::SearchMode::YBWC, othello::SearchMode::LAZY_SMP,
+        othello::SearchMode::SERIAL}) {
+    othello::Engine engine(evaluator, thread_pool, 1);
+    engine.setVerbose(false);
+    engine.setEndgameEmpties(0);
+    engine.setSearchMode(mode);
+    const auto start = std::chrono::steady_clock::now();
+    // Depth 40 takes far longer than the limit
+    const int move = engine.findBestMove(board, 40, othello::Color::BLACK, 50);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+    EXPECT_TRUE((legal >> move) & 1);
+    const othello::SearchStats stats = engine.lastSearchStats();
+    EXPECT_TRUE(stats.time_limit_hit);
+    EXPECT_FALSE(stats.stopped);
+    EXPECT_EQ(stats.best_move, move);
+  }
+
+  // Without time for a single iteration the first ordered move is returned
+  othello::Engine engine(evaluator, thread_pool, 1);
+  engine.setVerbose(false);
+  EXPECT_TRUE((legal >> engine.findBestMove(board, 10, othello::Color::BLACK,
+                                            0)) &
+              1);
+}
+
+TEST_F(EngineTest, TimeLimitStopsTheEndgameSolve) {
+  // 18 empties: within the default threshold, far beyond the limit to solve
+  const othello::GameBoard board = randomMidgames(1, 42, 7)[0];
+  ASSERT_LE(64 - std::popcount(board.black_bb | board.white_bb),
+            othello::kDefaultEndgameEmpties);
+  const uint64_t legal = othello::getPossibleMoves(board, othello::Color::BLACK);
+  for (const othello::SearchMode mode :
+       {othello::SearchMode::YBWC, othello::SearchMode::SERIAL}) {
+    othello::Engine engine(evaluator, thread_pool, 1);
+    engine.setVerbose(false);
+    engine.setSearchMode(mode);
+    const auto start = std::chrono::steady_clock::now();
+    const int move = engine.findBestMove(board, 60, othello::Color::BLACK, 10);
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    EXPECT_LT(elapsed, std::chrono::milliseconds(500));
+    EXPECT_TRUE((legal >> move) & 1);
+    const othello::SearchStats stats = engine.lastSearchStats();
+    EXPECT_TRUE(stats.time_limit_hit);
+    EXPECT_FALSE(stats.solved);
+    EXPECT_EQ(stats.best_move, move);
+  }
+
+  // The stop condition reaches the solver too
+  othello::Engine engine(evaluator, thread_pool, 1);
+  engine.setVerbose(false);
+  const int move = engine.findBestMove(board, 60, othello::Color::BLACK,
+                                       1 << 30, [] { return true; });
+  EXPECT_TRUE((legal >> move) & 1);
+  EXPECT_TRUE(engine.lastSearchStats().stopped);
+  EXPECT_FALSE(engine.lastSearchStats().solved);
+}
+
+TEST_F(EngineTest, StopsOnRequest) {
+  const othello::GameBoard board = randomMidgames(1, 12, 8)[0];
+  const uint64_t legal = othello::getPossibleMoves(board, othello::Color::BLACK);
+  othello::Engine engine(evaluator, thread_pool, 1);
+  engine.setVerbose(false);
+  engine.setEndgameEmpties(0);
+
+  // From another thread
+  std::thread stopper([&engine] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(50));
+    engine.stop();
+  });
+  int move = engine.findBestMove(board, 40, othello::Color::BLACK, 1 << 30);
+  stopper.join();
+  EXPECT_TRUE((legal >> move) & 1);
+  EXPECT_TRUE(engine.lastSearchStats().stopped);
+  EXPECT_FALSE(engine.lastSearchStats().time_limit_hit);
+
+  // Through the stop condition, polled by the searching threads
+  std::atomic<int> polls{0};
+  move = engine.findBestMove(board, 40, othello::Color::BLACK, 1 << 30,
+                             [&polls] { return ++polls > 20; });
+  EXPECT_TRUE((legal >> move) & 1);
+  EXPECT_TRUE(engine.lastSearchStats().stopped);
+  EXPECT_GT(engine.lastSearchStats().completed_depth, 0);
+
+  // A stop only affects the search it interrupts
+  move = engine.findBestMove(board, 4, othello::Color::BLACK, 1 << 30);
+  EXPECT_FALSE(engine.lastSearchStats().stopped);
+  EXPECT_EQ(engine.lastSearchStats().completed_depth, 4);
+}
+
+TEST_F(EngineTest, ReportsEveryIterationWithItsPrincipalVariation) {
+  const othello::GameBoard board = randomMidgames(1, 12, 9)[0];
+  othello::Engine engine(evaluator, thread_pool, 1);
+  engine.setVerbose(false);
+  engine.setEndgameEmpties(0);
+
+  std::vector<othello::IterationReport> reports;
+  othello::TimeManager time({1 << 30, 1 << 30}, false);
+  const int move = engine.findBestMove(
+      board, 6, othello::Color::BLACK, time, {},
+      [&reports](const othello::IterationReport &report) {
+        reports.push_back(report);
+      });
+  ASSERT_EQ(reports.size(), 6U);
+  EXPECT_EQ(reports.back().best_move, move);
+  EXPECT_EQ(reports.back().score, engine.lastSearchStats().score);
+  for (size_t i = 0; i < reports.size(); ++i) {
+    const othello::IterationReport &report = reports[i];
+    EXPECT_EQ(report.depth, static_cast<int>(i) + 1);
+    ASSERT_FALSE(report.principal_variation.empty());
+    EXPECT_EQ(report.principal_variation.front(), report.best_move);
+    EXPECT_LE(report.principal_variation.size(),
+              static_cast<size_t>(report.depth));
+    if (i > 0) {
+      EXPECT_GE(report.nodes_searched, reports[i - 1].nodes_searched);
+      EXPECT_GE(report.elapsed_ms, reports[i - 1].elapsed_ms);
+    }
+
+    // The variation is a legal line of play, with -1 for a pass
+    othello::GameBoard line = board;
+    othello::Color color = othello::Color::BLACK;
+    for (int square : report.principal_variation) {
+      const uint64_t legal = othello::getPossibleMoves(line, color);
+      if (square < 0) {
+        EXPECT_EQ(legal, 0U);
+      } else {
+        ASSERT_TRUE((legal >> square) & 1);
+        line = othello::applyMove(line, square, color);
+      }
+      color = othello::opponent(color);
+    }
+  }
+}
+
+TEST_F(EngineTest, MultiPvScoresEveryMoveExactly) {
+  for (const othello::GameBoard &board : randomMidgames(3, 14, 11)) {
+    const uint64_t legal =
+        othello::getPossibleMoves(board, othello::Color::BLACK);
+    othello::Engine engine(evaluator, thread_pool, 1);
+    engine.setEndgameEmpties(0);
+    othello::TimeManager time({1 << 30, 1 << 30}, false);
+    int reports = 0;
+    const std::vector<othello::RootLine> lines = engine.analyzeRootMoves(
+        board, 4, othello::Color::BLACK, 64, time, {},
+        [&reports](const othello::IterationReport &report) {
+          EXPECT_EQ(report.best_move, report.lines.front().move);
+          ++reports;
+        });
+    EXPECT_EQ(reports, 4);
+    ASSERT_EQ(lines.size(), static_cast<size_t>(std::popcount(legal)));
+    EXPECT_EQ(lines.front().score,
+              searchScore(board, othello::SearchDriver::FULL_WINDOW, 4));
+    EXPECT_EQ(engine.lastSearchStats().best_move, lines.front().move);
+
+    uint64_t seen = 0;
+    for (size_t i = 0; i < lines.size(); ++i) {
+      const othello::RootLine &line = lines[i];
+      ASSERT_TRUE((legal >> line.move) & 1);
+      seen |= 1ULL << line.move;
+      EXPECT_EQ(line.principal_variation.front(), line.move);
+      if (i > 0) {
+        EXPECT_LE(line.score, lines[i - 1].score);
+      }
+    }
+    EXPECT_EQ(seen, legal);
+
+    // The best two lines are the top of the full ranking
+    othello::Engine top_engine(evaluator, thread_pool, 1);
+    top_engine.setEndgameEmpties(0);
+    othello::TimeManager top_time({1 << 30, 1 << 30}, false);
+    const std::vector<othello::RootLine> top = top_engine.analyzeRootMoves(
+        board, 4, othello::Color::BLACK, 2, top_time);
+    ASSERT_EQ(top.size(), std::min<size_t>(2, lines.size()));
+    for (size_t i = 0; i < top.size(); ++i) {
+      EXPECT_EQ(top[i].score, lines[i].score);
+    }
+  }
+}
+
+TEST_F(EngineTest, MultiPvSolvesTheEndgame) {
+  const othello::GameBoard board = randomMidgames(1, 50, 3)[0];
+  othello::Engine engine(evaluator, thread_pool, 1);
+  engine.setVerbose(false);
+  const int best = engine.solveEndgame(board, othello::Color::BLACK);
+  const int expected = engine.lastSearchStats().score;
+
+  othello::TimeManager time({1 << 30, 1 << 30}, false);
+  const std::vector<othello::RootLine> lines =
+      engine.analyzeRootMoves(board, 1, othello::Color::BLACK, 64, time);
+  ASSERT_FALSE(lines.empty());
+  EXPECT_EQ(lines.front().score, expected);
+  EXPECT_EQ(lines.front().score % 100, 0);
+  EXPECT_TRUE(engine.lastSearchStats().solved);
+  bool found = false;
+  for (const othello::RootLine &line : lines) {
+    found |= line.move == best;
+  }
+  EXPECT_TRUE(found);
+}
+
+TEST(SearchDriver, ParsesNames) {
+  EXPECT_EQ(othello::parseSearchDriver("full"),
+            othello::SearchDriver::FULL_WINDOW);
+  EXPECT_EQ(othello::parseSearchDriver("aspiration"),
+            othello::SearchDriver::ASPIRATION);
+  EXPECT_EQ(othello::parseSearchDriver("mtdf"), othello::SearchDriver::MTDF);
+  EXPECT_FALSE(othello::parseSearchDriver("pvs").has_value());
+}
@@ -0,0 +1,131 @@
+// Copyright (c) 2026 Alex Li
+// test_EnginePool.cpp
+// Test cases for the engine pool admission queue
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <thread>
+
+#include "othello/EnginePool.hpp"
+#include "othello/evaluator/Evaluator.hpp"
+#include "utils/ThreadPool.hpp"
+
+class EnginePoolTest : public ::testing::Test {
+ protected:
+  othello::MobilityEvaluator evaluator;
+  utils::ThreadPool thread_pool{1};
+};
+
+TEST_F(EnginePoolTest, LeasesDistinctEnginesUpToLimit) {
+  othello::EnginePool pool(evaluator, thread_pool,
+                           {.engines = 2, .max_queue = 0, .tt_size_mb = 1});
+  auto first = pool.acquire();
+  auto second = pool.acquire();
+  ASSERT_TRUE(first.has_value());
+  ASSERT_TRUE(second.has_value());
+  EXPECT_NE(&**first, &**second);
+  EXPECT_EQ(pool.activeSearches(), 2u);
+
+  // No engine free and no queue space: backpressure
+  EXPECT_FALSE(pool.acquire().has_value());
+
+  first.reset();
+  EXPECT_EQ(pool.activeSearches(), 1u);
+  EXPECT_TRUE(pool.acquire().has_value());
+}
+
+TEST_F(EnginePoolTest, EnginesShareThePoolsHelpers) {
+  utils::ThreadPool workers(4);
+  othello::EnginePool pool(evaluator, workers,
+                           {.engines = 2, .max_queue = 0, .tt_size_mb = 1});
+  auto lease = pool.acquire();
+  ASSERT_TRUE(lease.has_value());
+  EXPECT_EQ((*lease)->helperThreads(), 2u);
+
+  othello::EnginePool crowded(evaluator, thread_pool,
+                              {.engines = 3, .max_queue = 0, .tt_size_mb = 1});
+  EXPECT_EQ((*crowded.acquire())->helperThreads(), 1u);
+}
+
+TEST_F(EnginePoolTest, QueuedRequestWaitsForRelease) {
+  othello::EnginePool pool(evaluator, thread_pool,
+                           {.engines = 1, .max_queue = 1, .tt_size_mb = 1});
+  std::optional<othello::EnginePool::Lease> held = pool.acquire();
+  ASSERT_TRUE(held.has_value());
+
+  std::atomic<bool> acquired{false};
+  std::thread waiter([&] {
+    auto lease = pool.acquire();
+    acquired = lease.has_value();
+  });
+  while (pool.queuedRequests() == 0) {
+    std::this_thread::yield();
+  }
+  // The single queue slot is taken, so a third request is rejected
+  EXPECT_FALSE(pool.acquire().has_value());
+  EXPECT_FALSE(acquired.load());
+
+  held.reset();
+  waiter.join();
+  EXPECT_TRUE(acquired.load());
+  EXPECT_EQ(pool.queuedRequests(), 0u);
+}
+
+TEST_F(EnginePoolTest, WaitEndsAtDeadlineOrStop) {
+  othello::EnginePool pool(evaluator, thread_pool,
+                           {.engines = 1, .max_queue = 2, .tt_size_mb = 1});
+  std::optional<othello::EnginePool::Lease> held = pool.acquire();
+  ASSERT_TRUE(held.has_value());
+
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(
+      pool.acquire(start + std::chrono::milliseconds(20)).has_value());
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+  EXPECT_EQ(pool.queuedRequests(), 0u);
+
+  // A request stopped at the head of the queue hands its turn to the next
+  std::atomic<bool> stopped{false};
+  std::atomic<bool> first_done{false};
+  std::thread first([&] {
+    EXPECT_FALSE(pool.acquire(std::chrono::steady_clock::time_point::max(),
+                              [&] { return stopped.load(); })
+                     .has_value());
+    first_done = true;
+  });
+  while (pool.queuedRequests() < 1) {
+    std::this_thread::yield();
+  }
+  std::atomic<bool> acquired{false};
+  std::thread second([&] { acquired = pool.acquire().has_value(); });
+  while (pool.queuedRequests() < 2) {
+    std::this_thread::yield();
+  }
+  stopped = true;
+  first.join();
+  EXPECT_EQ(pool.queuedRequests(), 1u);
+  held.reset();
+  second.join();
+  EXPECT_TRUE(acquired.load());
+
+  // One given up behind the head is skipped when its turn comes
+  std::optional<othello::EnginePool::Lease> again = pool.acquire();
+  ASSERT_TRUE(again.has_value());
+  acquired = false;
+  std::thread head([&] { acquired = pool.acquire().has_value(); });
+  while (pool.queuedRequests() < 1) {
+    std::this_thread::yield();
+  }
+  EXPECT_FALSE(pool.acquire(std::chrono::steady_clock::now() +
+                            std::chrono::milliseconds(10))
+                   .has_value());
+  EXPECT_EQ(pool.queuedRequests(), 1u);
+  again.reset();
+  head.join();
+  EXPECT_TRUE(acquired.load());
+  EXPECT_EQ(pool.queuedRequests(), 0u);
+  EXPECT_TRUE(pool.acquire().has_value());
+}
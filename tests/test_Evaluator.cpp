@@ -0,0 +1,86 @@
+// Copyright (c) 2026 Alex Li
+// test_Evaluator.cpp
+// Test cases checking incremental evaluation against full evaluation
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <random>
+
+#include "othello/GameBoard.hpp"
+#include "othello/OthelloRules.hpp"
+#include "othello/evaluator/Evaluator.hpp"
+#include "othello/evaluator/PatternEvaluator.hpp"
+
+namespace {
+
+/// Play random games, advancing an accumulator move by move, and check it
+/// against a full evaluation of every position reached
+void expectIncrementalMatchesFull(const othello::Evaluator &evaluator,
+                                  uint64_t seed) {
+  ASSERT_TRUE(evaluator.incremental());
+  std::mt19937_64 rng(seed);
+  for (int game = 0; game < 20; ++game) {
+    othello::GameBoard board = othello::createInitialBoard();
+    othello::EvalAccumulator accumulator;
+    evaluator.reset(board, accumulator);
+    EXPECT_EQ(evaluator.evaluate(board, accumulator), evaluator.evaluate(board));
+
+    while (true) {
+      const othello::Color color = board.current_turn;
+      uint64_t moves = othello::getPossibleMoves(board, color);
+      if (!moves) {
+        break;
+      }
+      for (int pick = static_cast<int>(rng() % std::popcount(moves)); pick > 0;
+           --pick) {
+        moves &= moves - 1;
+      }
+      const int move = std::countr_zero(moves);
+      uint64_t flips;
+      board = othello::applyMove(board, move, color, flips);
+      evaluator.update(accumulator, move, flips, color);
+      ASSERT_EQ(evaluator.evaluate(board, accumulator),
+                evaluator.evaluate(board))
+          << "game " << game << ", move " << move;
+      // As the search calls it, with the side to move's moves known
+      const othello::Color next = board.current_turn;
+      ASSERT_EQ(evaluator.evaluateWithMoves(
+                    board, accumulator, next,
+                    othello::getPossibleMoves(board, next)),
+                evaluator.evaluate(board))
+          << "game " << game << ", move " << move;
+    }
+  }
+}
+
+} // namespace
+
+TEST(Evaluator, ApplyMoveReportsFlippedDiscs) {
+  const othello::GameBoard board = othello::createInitialBoard();
+  uint64_t flips = 0;
+  const othello::GameBoard next =
+      othello::applyMove(board, 19, othello::Color::BLACK, flips);
+  EXPECT_EQ(flips, 1ULL << 27);
+  EXPECT_EQ(next.black_bb, board.black_bb | flips | (1ULL << 19));
+}
+
+TEST(Evaluator, PositionalIncrementalMatchesFull) {
+  expectIncrementalMatchesFull(othello::PositionalEvaluator(), 3);
+}
+
+TEST(Evaluator, MobilityIncrementalMatchesFull) {
+  expectIncrementalMatchesFull(othello::MobilityEvaluator(), 5);
+}
+
+TEST(Evaluator, PatternIncrementalMatchesFull) {
+  othello::PatternEvaluator evaluator;
+  std::mt19937_64 rng(7);
+  for (int phase = 0; phase < othello::PatternEvaluator::kPhases; ++phase) {
+    int16_t *weights = evaluator.phaseWeights(phase);
+    for (size_t i = 0; i < othello::PatternEvaluator::kWeightsPerPhase; ++i) {
+      weights[i] = static_cast<int16_t>(rng() % 201) - 100;
+    }
+  }
+  expectIncrementalMatchesFull(evaluator, 11);
+}
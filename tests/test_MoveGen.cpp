@@ -0,0 +1,98 @@
+// Copyright (c) 2026 Alex Li
+// test_MoveGen.cpp
+// Test cases checking every move generation kernel against the scalar one
+
+#include <gtest/gtest.h>
+
+#include <random>
+#include <string>
+
+#include "othello/MoveGen.hpp"
+#include "othello/OthelloRules.hpp"
+
+namespace {
+
+constexpr othello::SimdLevel kLevels[] = {othello::SimdLevel::SCALAR,
+                                          othello::SimdLevel::AVX2,
+                                          othello::SimdLevel::AVX512};
+
+/// Random disjoint pair of bitboards of varying density
+std::pair<uint64_t, uint64_t> randomPosition(std::mt19937_64 &rng) {
+  uint64_t occupied = rng();
+  for (int i = static_cast<int>(rng() % 3); i > 0; --i) {
+    occupied |= rng();
+  }
+  const uint64_t mine = occupied & rng();
+  return {mine, occupied & ~mine};
+}
+
+} // namespace
+
+TEST(MoveGen, ScalarKernelsAreAlwaysAvailable) {
+  const othello::MoveGenKernels *kernels =
+      othello::moveGenKernels(othello::SimdLevel::SCALAR);
+  ASSERT_NE(kernels, nullptr);
+  EXPECT_EQ(kernels->level, othello::SimdLevel::SCALAR);
+  EXPECT_LE(othello::activeMoveGen().level, othello::detectSimdLevel());
+}
+
+TEST(MoveGen, ParsesLevelNames) {
+  for (othello::SimdLevel level : kLevels) {
+    EXPECT_EQ(othello::parseSimdLevel(othello::simdLevelName(level)), level);
+  }
+  EXPECT_FALSE(othello::parseSimdLevel("sse2").has_value());
+}
+
+TEST(MoveGen, KernelsMatchScalar) {
+  const othello::MoveGenKernels &scalar =
+      *othello::moveGenKernels(othello::SimdLevel::SCALAR);
+  for (othello::SimdLevel level : kLevels) {
+    const othello::MoveGenKernels *kernels = othello::moveGenKernels(level);
+    if (kernels == nullptr) {
+      continue; // Not supported by this CPU
+    }
+    SCOPED_TRACE(std::string(othello::simdLevelName(level)));
+    std::mt19937_64 rng(29);
+    for (int i = 0; i < 5000; ++i) {
+      const auto [mine, theirs] = randomPosition(rng);
+      ASSERT_EQ(kernels->moves(mine, theirs), scalar.moves(mine, theirs));
+      for (uint64_t empty = ~(mine | theirs); empty; empty &= empty - 1) {
+        const int square = std::countr_zero(empty);
+        ASSERT_EQ(kernels->flips(mine, theirs, square),
+                  scalar.flips(mine, theirs, square))
+            << "square " << square;
+      }
+    }
+  }
+}
+
+TEST(MoveGen, ScalarFlipsMatchReferenceLoop) {
+  const othello::MoveGenKernels &scalar =
+      *othello::moveGenKernels(othello::SimdLevel::SCALAR);
+  std::mt19937_64 rng(31);
+  for (int i = 0; i < 5000; ++i) {
+    const auto [mine, theirs] = randomPosition(rng);
+    for (uint64_t empty = ~(mine | theirs); empty; empty &= empty - 1) {
+      const int square = std::countr_zero(empty);
+      ASSERT_EQ(scalar.flips(mine, theirs, square),
+                othello::referenceFlips(mine, theirs, square))
+          << "square " << square;
+    }
+  }
+  // Runs that reach the far edge with no disc of ours beyond them
+  EXPECT_EQ(scalar.flips(0, 0x7FULL, 7), 0u);
+  EXPECT_EQ(scalar.flips(0, 0xFEULL, 0), 0u);
+  EXPECT_EQ(scalar.flips(1ULL, 0x7EULL, 7), 0x7EULL);
+  EXPECT_EQ(scalar.flips(1ULL << 63, 0x0040201008040200ULL, 0),
+            0x0040201008040200ULL);
+}
+
+TEST(MoveGen, SelectSwitchesTheActiveKernels) {
+  const othello::SimdLevel original = othello::activeMoveGen().level;
+  ASSERT_TRUE(othello::selectMoveGen(othello::SimdLevel::SCALAR));
+  EXPECT_EQ(othello::activeMoveGen().level, othello::SimdLevel::SCALAR);
+  // The opening position has four moves whatever the kernels
+  EXPECT_EQ(othello::getMoves(othello::INITIAL_BLACK, othello::INITIAL_WHITE),
+            0x0000102004080000ULL);
+  ASSERT_TRUE(othello::selectMoveGen(original));
+}
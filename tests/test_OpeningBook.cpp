@@ -0,0 +1,158 @@
+// Copyright (c) 2026 Alex Li
+// test_OpeningBook.cpp
+// Test cases for the opening book's file format, lookups and engine use
+
+#include <gtest/gtest.h>
+
+#include <bit>
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "othello/Engine.hpp"
+#include "othello/GameBoard.hpp"
+#include "othello/OpeningBook.hpp"
+#include "othello/OthelloRules.hpp"
+#include "othello/Symmetry.hpp"
+#include "othello/evaluator/Evaluator.hpp"
+#include "utils/ThreadPool.hpp"
+
+namespace {
+
+std::string tempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+/// The board after a few fixed opening moves, black to move
+othello::GameBoard openingBoard() {
+  othello::GameBoard board = othello::createInitialBoard();
+  for (int move : {19, 18, 17}) {
+    board = othello::applyMove(board, move, board.current_turn);
+  }
+  return board;
+}
+
+/// Book entry recording move as the best move of board with color to move
+othello::BookEntry entryFor(const othello::GameBoard &board,
+                            othello::Color color, int move, int16_t score) {
+  const bool black = color == othello::Color::BLACK;
+  const othello::OpeningBook::Canonical position =
+      othello::OpeningBook::canonical(black ? board.black_bb : board.white_bb,
+                                      black ? board.white_bb : board.black_bb);
+  return othello::BookEntry{
+      .key = position.key,
+      .score = score,
+      .move = static_cast<uint8_t>(std::countr_zero(
+          othello::transform(1ULL << move, position.symmetry))),
+      .depth = 20,
+      .visits = 3,
+  };
+}
+
+} // namespace
+
+TEST(OpeningBook, CanonicalKeyIgnoresSymmetry) {
+  std::mt19937_64 rng(5);
+  for (int i = 0; i < 1000; ++i) {
+    const uint64_t occupied = rng() | rng();
+    const uint64_t player = occupied & rng();
+    const uint64_t opponent = occupied & ~player;
+    const uint64_t key = othello::OpeningBook::canonical(player, opponent).key;
+    for (int symmetry = 0; symmetry < othello::kSymmetries; ++symmetry) {
+      ASSERT_EQ(othello::untransform(othello::transform(player, symmetry),
+                                     symmetry),
+                player);
+      ASSERT_EQ(othello::OpeningBook::canonical(
+                    othello::transform(player, symmetry),
+                    othello::transform(opponent, symmetry))
+                    .key,
+                key);
+    }
+  }
+  // The side to move matters
+  EXPECT_NE(othello::OpeningBook::canonical(othello::INITIAL_BLACK,
+                                            othello::INITIAL_WHITE | 1)
+                .key,
+            othello::OpeningBook::canonical(othello::INITIAL_WHITE | 1,
+                                            othello::INITIAL_BLACK)
+                .key);
+}
+
+TEST(OpeningBook, ProbesEverySymmetricPosition) {
+  othello::initializeZobrist();
+  const othello::GameBoard board = openingBoard();
+  const othello::Color color = board.current_turn;
+  const int move = std::countr_zero(othello::getPossibleMoves(board, color));
+  const std::string path = tempPath("othello_book_test.bin");
+  othello::OpeningBook::save(path, {entryFor(board, color, move, -150)});
+  const othello::OpeningBook book(path);
+  std::remove(path.c_str()); // The mapping outlives the file name
+  ASSERT_EQ(book.size(), 1u);
+
+  for (int symmetry = 0; symmetry < othello::kSymmetries; ++symmetry) {
+    const uint64_t black = othello::transform(board.black_bb, symmetry);
+    const uint64_t white = othello::transform(board.white_bb, symmetry);
+    const othello::GameBoard mirrored(
+        black, white, othello::zobristHash(black, white, color), color);
+    const std::optional<othello::BookMove> hit = book.probe(mirrored, color);
+    ASSERT_TRUE(hit.has_value()) << "symmetry " << symmetry;
+    EXPECT_EQ(1ULL << hit->move, othello::transform(1ULL << move, symmetry));
+    EXPECT_EQ(hit->score, -150);
+    EXPECT_EQ(hit->depth, 20);
+    EXPECT_EQ(hit->visits, 3u);
+  }
+  EXPECT_FALSE(book.probe(othello::createInitialBoard(), othello::Color::BLACK)
+                   .has_value());
+}
+
+TEST(OpeningBook, RejectsMissingAndMalformedFiles) {
+  EXPECT_THROW(othello::OpeningBook(tempPath("othello_no_such_book.bin")),
+               std::runtime_error);
+  const std::string path = tempPath("othello_bad_book_test.bin");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "OTBK but not a book";
+  }
+  EXPECT_THROW(othello::OpeningBook book(path), std::runtime_error);
+  std::remove(path.c_str());
+
+  EXPECT_THROW(othello::OpeningBook::save(
+                   path, {othello::BookEntry{1, 0, 0, 1, 1},
+                          othello::BookEntry{1, 0, 0, 1, 1}}),
+               std::runtime_error);
+}
+
+TEST(OpeningBook, EngineAnswersBookPositionsWithoutSearching) {
+  othello::initializeZobrist();
+  const othello::GameBoard board = openingBoard();
+  const othello::Color color = board.current_turn;
+  // The book's move need not be the one a search would pick
+  uint64_t moves = othello::getPossibleMoves(board, color);
+  const int book_move = 63 - std::countl_zero(moves);
+  const std::string path = tempPath("othello_engine_book_test.bin");
+  othello::OpeningBook::save(path, {entryFor(board, color, book_move, 42)});
+  const othello::OpeningBook book(path);
+  std::remove(path.c_str());
+
+  othello::MobilityEvaluator evaluator;
+  utils::ThreadPool thread_pool(1);
+  othello::Engine engine(evaluator, thread_pool, 1);
+  engine.setVerbose(false);
+  engine.setOpeningBook(&book);
+  EXPECT_EQ(engine.findBestMove(board, 10, color, 1 << 30), book_move);
+  othello::SearchStats stats = engine.lastSearchStats();
+  EXPECT_TRUE(stats.book_hit);
+  EXPECT_EQ(stats.nodes_searched, 0u);
+  EXPECT_EQ(stats.score, 42);
+
+  // Positions outside the book are searched as usual
+  const othello::GameBoard next = othello::applyMove(board, book_move, color);
+  EXPECT_GE(engine.findBestMove(next, 3, next.current_turn, 1 << 30), 0);
+  stats = engine.lastSearchStats();
+  EXPECT_FALSE(stats.book_hit);
+  EXPECT_GT(stats.nodes_searched, 0u);
+}
@@ -5,6 +5,9 @@
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 
+#include <bit>
+#include <random>
+
 #include "othello/GameBoard.hpp"
 #include "othello/OthelloRules.hpp"
 #include "utils/BitboardUtils.hpp"
@@ -120,3 +123,70 @@ int main(int argc, char **argv) {
   return RUN_ALL_TESTS();
 }
 
+
+TEST_F(StartingBoardState, MakeMoveHandsTheTurnOverEvenToAPass) {
+  // Black takes the last white disc; white has no reply
+  const uint64_t black = 0x1ULL;
+  const uint64_t white = 0x2ULL;
+  const othello::GameBoard before(
+      black, white, othello::zobristHash(black, white, othello::Color::BLACK),
+      othello::Color::BLACK);
+
+  const othello::GameBoard made =
+      othello::makeMove(before, 2, othello::Color::BLACK, 0x2ULL);
+  EXPECT_EQ(made.black_bb, 0x7ULL);
+  EXPECT_EQ(made.white_bb, 0ULL);
+  EXPECT_EQ(made.current_turn, othello::Color::WHITE);
+  EXPECT_EQ(made.zobrist_hash,
+            othello::zobristHash(0x7ULL, 0, othello::Color::WHITE));
+
+  // applyMove resolves the pass; passTurn gets to the same position
+  const othello::GameBoard applied =
+      othello::applyMove(before, 2, othello::Color::BLACK);
+  const othello::GameBoard passed = othello::passTurn(made);
+  EXPECT_EQ(applied.current_turn, othello::Color::BLACK);
+  EXPECT_EQ(passed.current_turn, applied.current_turn);
+  EXPECT_EQ(passed.zobrist_hash, applied.zobrist_hash);
+}
+
+TEST(ZobristHash, KeysAreDeterministic) {
+  // The compiled-in keys are the default seed's
+  constexpr othello::ZobristKeys keys =
+      othello::makeZobristKeys(othello::kDefaultZobristSeed);
+  othello::initializeZobrist();
+  EXPECT_EQ(othello::zobrist_table, keys.squares);
+  EXPECT_EQ(othello::zobrist_black_turn, keys.black_turn);
+
+  // Any seed gives the same keys every time, and other seeds other keys
+  othello::initializeZobrist(42);
+  const othello::ZobristTable seeded = othello::zobrist_table;
+  EXPECT_EQ(seeded, othello::makeZobristKeys(42).squares);
+  EXPECT_NE(seeded, keys.squares);
+  othello::initializeZobrist();
+}
+
+TEST(ZobristHash, IncrementalHashMatchesFullHash) {
+  for (uint64_t seed : {othello::kDefaultZobristSeed, uint64_t{7}}) {
+    othello::initializeZobrist(seed);
+    std::mt19937_64 rng(seed);
+    for (int game = 0; game < 50; ++game) {
+      othello::GameBoard board = othello::createInitialBoard();
+      while (true) {
+        const othello::Color color = board.current_turn;
+        uint64_t moves = othello::getPossibleMoves(board, color);
+        if (!moves) {
+          break;
+        }
+        for (int pick = static_cast<int>(rng() % std::popcount(moves));
+             pick > 0; --pick) {
+          moves &= moves - 1;
+        }
+        board = othello::applyMove(board, std::countr_zero(moves), color);
+        ASSERT_EQ(board.zobrist_hash,
+                  othello::zobristHash(board.black_bb, board.white_bb,
+                                       board.current_turn));
+      }
+    }
+  }
+  othello::initializeZobrist();
+}
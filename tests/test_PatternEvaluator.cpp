@@ -0,0 +1,197 @@
+// Copyright (c) 2026 Alex Li
+// test_PatternEvaluator.cpp
+// Test cases for the pattern evaluator and the board symmetries it uses
+
+#include <gtest/gtest.h>
+
+#include <cstdio>
+#include <filesystem>
+#include <fstream>
+#include <random>
+#include <stdexcept>
+#include <string>
+
+#include "othello/GameBoard.hpp"
+#include "othello/Symmetry.hpp"
+#include "othello/evaluator/PatternEvaluator.hpp"
+#include "utils/BitboardUtils.hpp"
+
+namespace {
+
+/// Start of the 2x5 corner table, the only pattern placed in all eight
+/// orientations
+constexpr size_t kCorner2x5Offset = 59049 + 19683;
+constexpr size_t kCorner2x5Size = 59049;
+
+/// Random disjoint pair of bitboards
+std::pair<uint64_t, uint64_t> randomPosition(std::mt19937_64 &rng) {
+  const uint64_t occupied = rng() | rng();
+  const uint64_t player = occupied & rng();
+  return {player, occupied & ~player};
+}
+
+std::string tempPath(const std::string &name) {
+  return (std::filesystem::temp_directory_path() / name).string();
+}
+
+} // namespace
+
+TEST(Symmetry, TransformsMoveSquaresAsDocumented) {
+  for (int row = 0; row < 8; ++row) {
+    for (int col = 0; col < 8; ++col) {
+      const uint64_t square = 1ULL << (row * 8 + col);
+      EXPECT_EQ(othello::flipVertical(square), 1ULL << ((7 - row) * 8 + col));
+      EXPECT_EQ(othello::flipHorizontal(square), 1ULL << (row * 8 + 7 - col));
+      EXPECT_EQ(othello::flipDiagonal(square), 1ULL << (col * 8 + row));
+    }
+  }
+}
+
+TEST(Symmetry, TransformsAreDistinct) {
+  // A board without any symmetry maps to eight different boards
+  const uint64_t board = 0x0000000000000107ULL;
+  for (int a = 0; a < othello::kSymmetries; ++a) {
+    for (int b = a + 1; b < othello::kSymmetries; ++b) {
+      EXPECT_NE(othello::transform(board, a), othello::transform(board, b));
+    }
+  }
+}
+
+TEST(Symmetry, CanonicalizePicksTheSmallestForm) {
+  std::mt19937_64 rng(9);
+  for (int i = 0; i < 1000; ++i) {
+    const uint64_t first = rng() & rng();
+    const uint64_t second = rng() & ~first;
+    const othello::CanonicalBoards canonical =
+        othello::canonicalize(first, second);
+    EXPECT_EQ(othello::transform(first, canonical.symmetry), canonical.first);
+    EXPECT_EQ(othello::transform(second, canonical.symmetry),
+              canonical.second);
+    for (int symmetry = 0; symmetry < othello::kSymmetries; ++symmetry) {
+      const uint64_t f = othello::transform(first, symmetry);
+      const uint64_t s = othello::transform(second, symmetry);
+      EXPECT_TRUE(canonical.first < f ||
+                  (canonical.first == f && canonical.second <= s));
+      const othello::CanonicalBoards mirrored = othello::canonicalize(f, s);
+      EXPECT_EQ(mirrored.first, canonical.first);
+      EXPECT_EQ(mirrored.second, canonical.second);
+    }
+  }
+  for (int square = 0; square < 64; ++square) {
+    for (int symmetry = 0; symmetry < othello::kSymmetries; ++symmetry) {
+      EXPECT_EQ(othello::untransformSquare(
+                    othello::transformSquare(square, symmetry), symmetry),
+                square);
+    }
+  }
+}
+
+TEST(BitboardUtils, ExtractBitsGathersMaskedBitsInOrder) {
+  std::mt19937_64 rng(5);
+  for (int i = 0; i < 1000; ++i) {
+    const uint64_t value = rng();
+    const uint64_t mask = rng() & rng();
+    uint64_t expected = 0;
+    int out = 0;
+    for (int bit = 0; bit < 64; ++bit) {
+      if (mask & (1ULL << bit)) {
+        expected |= ((value >> bit) & 1ULL) << out++;
+      }
+    }
+    EXPECT_EQ(othello::extractBits(value, mask), expected);
+  }
+}
+
+TEST(PatternEvaluator, FeaturesStayInsideThePhaseTables) {
+  std::mt19937_64 rng(9);
+  othello::PatternEvaluator::Features features;
+  for (int i = 0; i < 1000; ++i) {
+    const auto [player, opponent] = randomPosition(rng);
+    othello::PatternEvaluator::features(player, opponent, features);
+    for (uint32_t index : features) {
+      EXPECT_LT(index, othello::PatternEvaluator::kWeightsPerPhase);
+    }
+    const int phase = othello::PatternEvaluator::phase(player, opponent);
+    EXPECT_GE(phase, 0);
+    EXPECT_LT(phase, othello::PatternEvaluator::kPhases);
+  }
+}
+
+TEST(PatternEvaluator, FullySymmetricPatternIsInvariantUnderSymmetries) {
+  othello::PatternEvaluator evaluator;
+  std::mt19937_64 rng(13);
+  for (int phase = 0; phase < othello::PatternEvaluator::kPhases; ++phase) {
+    int16_t *weights = evaluator.phaseWeights(phase);
+    for (size_t i = 0; i < kCorner2x5Size; ++i) {
+      weights[kCorner2x5Offset + i] = static_cast<int16_t>(rng() % 201) - 100;
+    }
+  }
+
+  for (int i = 0; i < 200; ++i) {
+    const auto [player, opponent] = randomPosition(rng);
+    const int score = evaluator.evaluate(player, opponent);
+    for (int symmetry = 1; symmetry < othello::kSymmetries; ++symmetry) {
+      EXPECT_EQ(evaluator.evaluate(othello::transform(player, symmetry),
+                                   othello::transform(opponent, symmetry)),
+                score);
+    }
+  }
+}
+
+TEST(PatternEvaluator, BoardScoreIsFromBlacksPerspective) {
+  othello::PatternEvaluator evaluator;
+  std::mt19937_64 rng(17);
+  for (int phase = 0; phase < othello::PatternEvaluator::kPhases; ++phase) {
+    int16_t *weights = evaluator.phaseWeights(phase);
+    for (size_t i = 0; i < othello::PatternEvaluator::kWeightsPerPhase; ++i) {
+      weights[i] = static_cast<int16_t>(rng() % 21) - 10;
+    }
+  }
+
+  const auto [black, white] = randomPosition(rng);
+  const othello::GameBoard black_to_move(black, white, 0,
+                                         othello::Color::BLACK);
+  const othello::GameBoard white_to_move(black, white, 0,
+                                         othello::Color::WHITE);
+  EXPECT_EQ(evaluator.evaluate(black_to_move), evaluator.evaluate(black, white));
+  EXPECT_EQ(evaluator.evaluate(white_to_move),
+            -evaluator.evaluate(white, black));
+}
+
+TEST(PatternEvaluator, WeightsSurviveSaveAndLoad) {
+  othello::PatternEvaluator evaluator;
+  std::mt19937_64 rng(21);
+  for (int phase = 0; phase < othello::PatternEvaluator::kPhases; ++phase) {
+    int16_t *weights = evaluator.phaseWeights(phase);
+    for (size_t i = 0; i < othello::PatternEvaluator::kWeightsPerPhase; ++i) {
+      weights[i] = static_cast<int16_t>(rng());
+    }
+  }
+  const std::string path = tempPath("othello_pattern_weights_test.bin");
+  evaluator.save(path);
+
+  const othello::PatternEvaluator loaded(path);
+  std::remove(path.c_str());
+  for (int phase = 0; phase < othello::PatternEvaluator::kPhases; ++phase) {
+    for (size_t i = 0; i < othello::PatternEvaluator::kWeightsPerPhase; ++i) {
+      ASSERT_EQ(loaded.phaseWeights(phase)[i], evaluator.phaseWeights(phase)[i]);
+    }
+  }
+}
+
+TEST(PatternEvaluator, RejectsMalformedWeightsFiles) {
+  othello::PatternEvaluator evaluator;
+  evaluator.phaseWeights(0)[0] = 42;
+
+  EXPECT_THROW(evaluator.load(tempPath("othello_no_such_weights.bin")),
+               std::runtime_error);
+
+  const std::string path = tempPath("othello_bad_weights_test.bin");
+  {
+    std::ofstream out(path, std::ios::binary);
+    out << "not a weights file";
+  }
+  EXPECT_THROW(evaluator.load(path), std::runtime_error);
+  std::remove(path.c_str());
+  EXPECT_EQ(evaluator.phaseWeights(0)[0], 42);
+}
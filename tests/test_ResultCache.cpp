@@ -0,0 +1,283 @@
+// Copyright (c) 2026 Alex Li
+// test_ResultCache.cpp
+// Test cases for the search result cache
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <optional>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "othello/GameBoard.hpp"
+#include "othello/OthelloRules.hpp"
+#include "othello/ResultCache.hpp"
+#include "othello/Symmetry.hpp"
+
+namespace {
+
+/// A position without any symmetry, black to move
+othello::GameBoard asymmetricBoard() {
+  othello::GameBoard board = othello::createInitialBoard();
+  for (int move : {19, 18, 17}) {
+    board = othello::applyMove(board, move, board.current_turn);
+  }
+  return board;
+}
+
+othello::GameBoard mirrored(const othello::GameBoard &board, int symmetry) {
+  const uint64_t black = othello::transform(board.black_bb, symmetry);
+  const uint64_t white = othello::transform(board.white_bb, symmetry);
+  return othello::GameBoard(
+      black, white, othello::zobristHash(black, white, board.current_turn),
+      board.current_turn);
+}
+
+/// Search that counts its calls and always answers move
+othello::ResultCache::Search countingSearch(std::atomic<int> &calls,
+                                            int move) {
+  return [&calls, move]() -> std::optional<othello::CachedSearch> {
+    ++calls;
+    return othello::CachedSearch{move, 25};
+  };
+}
+
+} // namespace
+
+TEST(ResultCache, AnswersRepeatsWithoutSearching) {
+  othello::initializeZobrist();
+  othello::ResultCache cache(1 << 20);
+  const othello::GameBoard board = asymmetricBoard();
+  const othello::Color color = board.current_turn;
+  std::atomic<int> calls{0};
+  othello::ResultCache::Outcome outcome;
+
+  auto result = cache.lookup(board, color, 8, 1000, countingSearch(calls, 20),
+                             &outcome);
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::MISS);
+  EXPECT_EQ(result->best_move, 20);
+
+  // Same request, a nearby time limit, and every mirror image
+  EXPECT_EQ(cache.lookup(board, color, 8, 1000, countingSearch(calls, 0),
+                         &outcome)->best_move,
+            20);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::HIT);
+  EXPECT_EQ(cache.lookup(board, color, 8, 1020, countingSearch(calls, 0),
+                         &outcome)->eval_score,
+            25);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::HIT);
+  for (int symmetry = 1; symmetry < othello::kSymmetries; ++symmetry) {
+    result = cache.lookup(mirrored(board, symmetry), color, 8, 1000,
+                          countingSearch(calls, 0), &outcome);
+    EXPECT_EQ(outcome, othello::ResultCache::Outcome::HIT);
+    EXPECT_EQ(result->best_move, othello::transformSquare(20, symmetry));
+  }
+  EXPECT_EQ(calls.load(), 1);
+
+  // Another depth, time bucket or side to move is another request
+  cache.lookup(board, color, 9, 1000, countingSearch(calls, 20), &outcome);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::MISS);
+  cache.lookup(board, color, 8, 3000, countingSearch(calls, 20), &outcome);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::MISS);
+  cache.lookup(board, othello::opponent(color), 8, 1000,
+               countingSearch(calls, 20), &outcome);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::MISS);
+
+  const othello::ResultCache::Stats stats = cache.stats();
+  EXPECT_EQ(stats.hits, 9u);
+  EXPECT_EQ(stats.misses, 4u);
+  EXPECT_EQ(stats.entries, 4u);
+}
+
+TEST(ResultCache, DoesNotCacheFailures) {
+  othello::ResultCache cache(1 << 20);
+  const othello::GameBoard board = othello::createInitialBoard();
+  othello::ResultCache::Outcome outcome;
+  EXPECT_FALSE(cache
+                   .lookup(board, othello::Color::BLACK, 8, 1000,
+                           [] { return std::optional<othello::CachedSearch>(); })
+                   .has_value());
+  EXPECT_THROW(cache.lookup(board, othello::Color::BLACK, 8, 1000,
+                            []() -> std::optional<othello::CachedSearch> {
+                              throw std::runtime_error("search failed");
+                            }),
+               std::runtime_error);
+  // A search cut short still answers its request
+  EXPECT_EQ(cache
+                .lookup(board, othello::Color::BLACK, 8, 1000,
+                        [] {
+                          return std::optional<othello::CachedSearch>(
+                              {.best_move = 26, .eval_score = 0,
+                               .cacheable = false});
+                        })
+                ->best_move,
+            26);
+  std::atomic<int> calls{0};
+  cache.lookup(board, othello::Color::BLACK, 8, 1000, countingSearch(calls, 19),
+               &outcome);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::MISS);
+  EXPECT_EQ(calls.load(), 1);
+  EXPECT_EQ(cache.stats().entries, 1u);
+}
+
+TEST(ResultCache, ClockKeepsRecentlyHitEntries) {
+  othello::ResultCache cache(1);
+  EXPECT_EQ(cache.capacity(), 0u);
+
+  othello::ResultCache small(1024);
+  const size_t capacity = small.capacity();
+  ASSERT_GE(capacity, 2u);
+  std::atomic<int> calls{0};
+  const othello::GameBoard board = othello::createInitialBoard();
+  // Depths tell the entries apart
+  for (size_t depth = 1; depth <= capacity; ++depth) {
+    small.lookup(board, othello::Color::BLACK, static_cast<uint8_t>(depth),
+                 1000, countingSearch(calls, 19));
+  }
+  // Hit the first entry, then add one more: the second is evicted instead
+  othello::ResultCache::Outcome outcome;
+  small.lookup(board, othello::Color::BLACK, 1, 1000,
+               countingSearch(calls, 19), &outcome);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::HIT);
+  small.lookup(board, othello::Color::BLACK,
+               static_cast<uint8_t>(capacity + 1), 1000,
+               countingSearch(calls, 19));
+  small.lookup(board, othello::Color::BLACK, 1, 1000,
+               countingSearch(calls, 19), &outcome);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::HIT);
+  small.lookup(board, othello::Color::BLACK, 2, 1000,
+               countingSearch(calls, 19), &outcome);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::MISS);
+  EXPECT_EQ(small.stats().entries, capacity);
+  EXPECT_GE(small.stats().evictions, 2u);
+}
+
+TEST(ResultCache, CoalescesConcurrentIdenticalRequests) {
+  othello::ResultCache cache(1 << 20);
+  const othello::GameBoard board = othello::createInitialBoard();
+  constexpr int kRequests = 6;
+  std::atomic<int> calls{0};
+  std::atomic<int> coalesced{0};
+
+  // The first search holds on until every other request is waiting for it
+  auto slow_search = [&]() -> std::optional<othello::CachedSearch> {
+    ++calls;
+    const auto deadline =
+        std::chrono::steady_clock::now() + std::chrono::seconds(5);
+    while (cache.stats().coalesced < kRequests - 1 &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+    return othello::CachedSearch{19, 0};
+  };
+
+  std::vector<std::thread> requests;
+  std::atomic<int> answered{0};
+  for (int i = 0; i < kRequests; ++i) {
+    requests.emplace_back([&] {
+      othello::ResultCache::Outcome outcome;
+      const auto result = cache.lookup(board, othello::Color::BLACK, 8, 1000,
+                                       slow_search, &outcome);
+      if (result && result->best_move == 19) {
+        ++answered;
+      }
+      if (outcome == othello::ResultCache::Outcome::COALESCED) {
+        ++coalesced;
+      }
+    });
+  }
+  for (std::thread &request : requests) {
+    request.join();
+  }
+  EXPECT_EQ(calls.load(), 1);
+  EXPECT_EQ(answered.load(), kRequests);
+  EXPECT_EQ(coalesced.load(), kRequests - 1);
+}
+
+TEST(ResultCache, WaitersSearchAgainAfterACutShortSearch) {
+  othello::ResultCache cache(1 << 20);
+  const othello::GameBoard board = othello::createInitialBoard();
+  std::atomic<int> calls{0};
+
+  // The first request is cancelled once a second, with more time, waits
+  std::thread leader([&] {
+    const auto result = cache.lookup(
+        board, othello::Color::BLACK, 8, 1000,
+        [&]() -> std::optional<othello::CachedSearch> {
+          ++calls;
+          const auto deadline =
+              std::chrono::steady_clock::now() + std::chrono::seconds(5);
+          while (cache.stats().coalesced < 1 &&
+                 std::chrono::steady_clock::now() < deadline) {
+            std::this_thread::sleep_for(std::chrono::milliseconds(1));
+          }
+          return othello::CachedSearch{
+              .best_move = 26, .eval_score = 0, .cacheable = false};
+        });
+    EXPECT_EQ(result->best_move, 26);
+  });
+  while (cache.stats().misses < 1) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  othello::ResultCache::Outcome outcome;
+  const auto result = cache.lookup(board, othello::Color::BLACK, 8, 1000,
+                                   countingSearch(calls, 19), &outcome);
+  leader.join();
+  ASSERT_TRUE(result.has_value());
+  EXPECT_EQ(result->best_move, 19);
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::MISS);
+  EXPECT_EQ(calls.load(), 2);
+  EXPECT_EQ(cache.stats().entries, 1u);
+}
+
+TEST(ResultCache, WaitersGiveUpAtTheirLimit) {
+  othello::ResultCache cache(1 << 20);
+  const othello::GameBoard board = othello::createInitialBoard();
+  std::atomic<bool> release{false};
+  std::thread leader([&] {
+    cache.lookup(board, othello::Color::BLACK, 8, 1000,
+                 [&]() -> std::optional<othello::CachedSearch> {
+                   while (!release.load()) {
+                     std::this_thread::sleep_for(std::chrono::milliseconds(1));
+                   }
+                   return othello::CachedSearch{19, 0};
+                 });
+  });
+  while (cache.stats().misses < 1) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+
+  std::atomic<int> calls{0};
+  othello::ResultCache::Outcome outcome;
+  const auto start = std::chrono::steady_clock::now();
+  EXPECT_FALSE(cache
+                   .lookup(board, othello::Color::BLACK, 8, 1000,
+                           countingSearch(calls, 20), &outcome,
+                           {.deadline = start + std::chrono::milliseconds(20),
+                            .stop = {}})
+                   .has_value());
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::GAVE_UP);
+  EXPECT_GE(std::chrono::steady_clock::now() - start,
+            std::chrono::milliseconds(20));
+
+  // A stop predicate ends the wait too
+  std::atomic<bool> cancelled{false};
+  std::thread canceller([&] {
+    std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    cancelled = true;
+  });
+  EXPECT_FALSE(cache
+                   .lookup(board, othello::Color::BLACK, 8, 1000,
+                           countingSearch(calls, 20), &outcome,
+                           {.stop = [&] { return cancelled.load(); }})
+                   .has_value());
+  EXPECT_EQ(outcome, othello::ResultCache::Outcome::GAVE_UP);
+  canceller.join();
+  EXPECT_EQ(calls.load(), 0);
+
+  release = true;
+  leader.join();
+}
@@ -0,0 +1,146 @@
+// Copyright (c) 2026 Alex Li
+// test_ThreadPool.cpp
+// Test cases for the work-stealing thread pool
+
+#include <gtest/gtest.h>
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <ctime>
+#include <numeric>
+#include <thread>
+#include <stdexcept>
+
+#include "utils/ThreadPool.hpp"
+
+namespace {
+/// @brief Sum [lo, hi) by recursively splitting into spawned halves
+long parallelSum(utils::ThreadPool &pool, long lo, long hi) {
+  if (hi - lo <= 16) {
+    long sum = 0;
+    for (long i = lo; i < hi; ++i) {
+      sum += i;
+    }
+    return sum;
+  }
+  const long mid = lo + (hi - lo) / 2;
+  long left = 0;
+  utils::TaskGroup group;
+  utils::Task task([&] { left = parallelSum(pool, lo, mid); });
+  pool.spawn(group, task);
+  const long right = parallelSum(pool, mid, hi);
+  pool.wait(group);
+  return left + right;
+}
+} // namespace
+
+TEST(ThreadPool, EnqueueReturnsResult) {
+  utils::ThreadPool pool(2);
+  auto future = pool.enqueue([](int a, int b) { return a * b; }, 6, 7);
+  EXPECT_EQ(future.get(), 42);
+}
+
+TEST(ThreadPool, EnqueuePropagatesExceptions) {
+  utils::ThreadPool pool(1);
+  auto future = pool.enqueue([]() -> int { throw std::runtime_error("x"); });
+  EXPECT_THROW(future.get(), std::runtime_error);
+}
+
+TEST(ThreadPool, SpawnedTasksAllRun) {
+  utils::ThreadPool pool(3);
+  std::atomic<int> counter{0};
+  std::array<utils::Task, 100> tasks;
+  utils::TaskGroup group;
+  for (auto &task : tasks) {
+    task.emplace([&counter] { counter.fetch_add(1); });
+    pool.spawn(group, task);
+  }
+  pool.wait(group);
+  EXPECT_EQ(counter.load(), 100);
+}
+
+TEST(ThreadPool, WaitRethrowsATaskException) {
+  utils::ThreadPool pool(2);
+  std::atomic<int> counter{0};
+  std::array<utils::Task, 20> tasks;
+  utils::TaskGroup group;
+  for (size_t i = 0; i < tasks.size(); ++i) {
+    tasks[i].emplace([&counter, i] {
+      counter.fetch_add(1);
+      if (i % 5 == 0) {
+        throw std::runtime_error("task failed");
+      }
+    });
+    pool.spawn(group, tasks[i]);
+  }
+  // Every task still finishes before the exception surfaces
+  EXPECT_THROW(pool.wait(group), std::runtime_error);
+  EXPECT_TRUE(group.done());
+  EXPECT_EQ(counter.load(), 20);
+
+  // The group and the pool stay usable
+  tasks[0].emplace([&counter] { counter.fetch_add(1); });
+  pool.spawn(group, tasks[0]);
+  EXPECT_NO_THROW(pool.wait(group));
+  EXPECT_EQ(counter.load(), 21);
+}
+
+TEST(ThreadPool, TasksKnowWhenTheyRunInsideWait) {
+  utils::ThreadPool pool(1);
+  EXPECT_FALSE(utils::ThreadPool::insideWait());
+  auto outside = pool.enqueue([] { return utils::ThreadPool::insideWait(); });
+  EXPECT_FALSE(outside.get());
+
+  // A task that waits runs its child itself when the only worker is busy
+  auto nested = pool.enqueue([&pool] {
+    bool inside = false;
+    utils::Task child([&inside] { inside = utils::ThreadPool::insideWait(); });
+    utils::TaskGroup group;
+    pool.spawn(group, child);
+    pool.wait(group);
+    return inside && !utils::ThreadPool::insideWait();
+  });
+  EXPECT_TRUE(nested.get());
+}
+
+TEST(ThreadPool, OutsideWaitSleepsUntilTheGroupFinishes) {
+  utils::ThreadPool pool(1);
+  utils::Task task(
+      [] { std::this_thread::sleep_for(std::chrono::milliseconds(300)); });
+  utils::TaskGroup group;
+  pool.spawn(group, task);
+  // Let the worker take the task, leaving nothing for this thread to run
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  const std::clock_t cpu_start = std::clock();
+  pool.wait(group);
+  const double cpu_ms =
+      1000.0 * static_cast<double>(std::clock() - cpu_start) / CLOCKS_PER_SEC;
+  EXPECT_TRUE(group.done());
+  // Spinning would take about the whole sleep
+  EXPECT_LT(cpu_ms, 100.0);
+}
+
+// Workers waiting on their own children must keep executing tasks rather
+// than blocking; with a single worker this would otherwise deadlock.
+TEST(ThreadPool, NestedWaitDoesNotDeadlock) {
+  for (size_t threads : {1u, 4u}) {
+    utils::ThreadPool pool(threads);
+    auto future = pool.enqueue([&pool] { return parallelSum(pool, 0, 4096); });
+    EXPECT_EQ(future.get(), 4096L * 4095 / 2);
+  }
+}
+
+TEST(ThreadPool, LargeCallablesFallBackToHeap) {
+  utils::ThreadPool pool(1);
+  std::array<long, 64> values{};
+  std::iota(values.begin(), values.end(), 1);
+  long sum = 0;
+  utils::Task task([values, &sum] {
+    sum = std::accumulate(values.begin(), values.end(), 0L);
+  });
+  utils::TaskGroup group;
+  pool.spawn(group, task);
+  pool.wait(group);
+  EXPECT_EQ(sum, 64L * 65 / 2);
+}
@@ -0,0 +1,103 @@
+// Copyright (c) 2026 Alex Li
+// test_TimeManager.cpp
+// Test cases for per-move time allocation and iteration decisions
+
+#include <gtest/gtest.h>
+
+#include <chrono>
+#include <limits>
+
+#include "othello/Engine.hpp"
+#include "othello/GameBoard.hpp"
+#include "othello/OthelloRules.hpp"
+#include "othello/TimeManager.hpp"
+#include "othello/evaluator/Evaluator.hpp"
+#include "utils/ThreadPool.hpp"
+
+TEST(TimeManager, AllocatesFromTheClock) {
+  const othello::GameClock clock{60000, 0};
+  const othello::MoveBudget opening = othello::TimeManager::allocate(clock, 56);
+  const othello::MoveBudget midgame = othello::TimeManager::allocate(clock, 36);
+  const othello::MoveBudget endgame = othello::TimeManager::allocate(clock, 4);
+  for (const othello::MoveBudget &budget : {opening, midgame, endgame}) {
+    EXPECT_GT(budget.soft_ms, 0);
+    EXPECT_LE(budget.soft_ms, budget.hard_ms);
+    EXPECT_LE(budget.hard_ms, clock.remaining_ms);
+  }
+  // The midgame gets more than the opening, and fewer moves left leave more
+  // for each
+  EXPECT_GT(midgame.soft_ms, opening.soft_ms);
+  EXPECT_GT(endgame.soft_ms, midgame.soft_ms);
+
+  // Most of the increment is spent on the move
+  const othello::MoveBudget with_increment =
+      othello::TimeManager::allocate({60000, 1000}, 36);
+  EXPECT_GE(with_increment.soft_ms, midgame.soft_ms + 500);
+
+  // An empty or huge clock still gives a usable budget
+  const othello::MoveBudget flagged = othello::TimeManager::allocate({0, 0}, 30);
+  EXPECT_GE(flagged.soft_ms, 1);
+  EXPECT_GE(flagged.hard_ms, flagged.soft_ms);
+  const othello::MoveBudget huge = othello::TimeManager::allocate(
+      {std::numeric_limits<int>::max(), std::numeric_limits<int>::max()}, 2);
+  EXPECT_GT(huge.soft_ms, 0);
+  EXPECT_GE(huge.hard_ms, huge.soft_ms);
+}
+
+TEST(TimeManager, SkipsIterationsPredictedToOverrun) {
+  othello::TimeManager time({200, 300});
+  EXPECT_TRUE(time.startIteration(0));
+  time.iterationCompleted(19, 1000, 10);
+  EXPECT_TRUE(time.startIteration(10));
+  time.iterationCompleted(19, 4000, 50);
+  EXPECT_DOUBLE_EQ(time.predictedIterationMs(), 160);
+  EXPECT_TRUE(time.startIteration(50));
+  // Growing fivefold, the next iteration would end at 650 ms
+  time.iterationCompleted(19, 20000, 150);
+  EXPECT_DOUBLE_EQ(time.predictedIterationMs(), 500);
+  EXPECT_FALSE(time.startIteration(150));
+
+  // A flat limit starts iterations until it has passed
+  othello::TimeManager flat({300, 300}, false);
+  flat.iterationCompleted(19, 1000, 10);
+  flat.iterationCompleted(19, 4000, 50);
+  flat.iterationCompleted(19, 20000, 150);
+  EXPECT_TRUE(flat.startIteration(150));
+  EXPECT_FALSE(flat.startIteration(300));
+}
+
+TEST(TimeManager, StableBestMovesShrinkTheSoftLimit) {
+  othello::TimeManager time({100, 1000});
+  time.iterationCompleted(19, 1000, 1);
+  EXPECT_DOUBLE_EQ(time.softLimitMs(), 100);
+  time.iterationCompleted(26, 1000, 2); // The best move changed
+  EXPECT_DOUBLE_EQ(time.softLimitMs(), 150);
+  for (int i = 0; i < 4; ++i) {
+    time.iterationCompleted(26, 1000, 3 + i);
+  }
+  EXPECT_DOUBLE_EQ(time.softLimitMs(), 60);
+  EXPECT_FALSE(time.startIteration(61));
+}
+
+TEST(TimeManager, EngineStopsStartingIterationsAtTheSoftLimit) {
+  othello::initializeZobrist();
+  othello::MobilityEvaluator evaluator;
+  utils::ThreadPool thread_pool(2);
+  othello::Engine engine(evaluator, thread_pool, 1);
+  engine.setVerbose(false);
+  engine.setEndgameEmpties(0);
+  const othello::GameBoard board = othello::createInitialBoard();
+
+  othello::TimeManager time({20, 5000});
+  const auto start = std::chrono::steady_clock::now();
+  const int move = engine.findBestMove(board, 40, othello::Color::BLACK, time);
+  const auto elapsed = std::chrono::steady_clock::now() - start;
+  EXPECT_TRUE((othello::getPossibleMoves(board, othello::Color::BLACK) >>
+               move) &
+              1);
+  EXPECT_LT(elapsed, std::chrono::milliseconds(2500));
+  const othello::SearchStats stats = engine.lastSearchStats();
+  EXPECT_TRUE(stats.time_limit_hit);
+  EXPECT_FALSE(stats.stopped);
+  EXPECT_GT(stats.completed_depth, 0);
+}
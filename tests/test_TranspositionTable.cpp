@@ -0,0 +1,91 @@
+// Copyright (c) 2026 Alex Li
+// test_TranspositionTable.cpp
+// Test cases for the shared transposition table
+
+#include <gtest/gtest.h>
+
+#include "othello/TranspositionTable.hpp"
+
+TEST(TranspositionTable, SizeIsPowerOfTwoBuckets) {
+  othello::TranspositionTable tt(3);
+  EXPECT_EQ(tt.sizeBytes(), 2u * 1024 * 1024);
+  EXPECT_EQ(tt.bucketCount() & (tt.bucketCount() - 1), 0u);
+}
+
+TEST(TranspositionTable, StoreThenProbeRoundTrips) {
+  othello::TranspositionTable tt(1);
+  othello::TTEntry entry{};
+  EXPECT_FALSE(tt.probe(0x1234ULL, entry));
+
+  tt.store(0x1234ULL, -4321, 7, othello::BoundType::UPPER, 42);
+  ASSERT_TRUE(tt.probe(0x1234ULL, entry));
+  EXPECT_EQ(entry.score, -4321);
+  EXPECT_EQ(entry.depth, 7);
+  EXPECT_EQ(entry.bound_type, othello::BoundType::UPPER);
+  EXPECT_EQ(entry.move_index, 42);
+}
+
+TEST(TranspositionTable, KeyVerificationRejectsBucketCollisions) {
+  othello::TranspositionTable tt(1);
+  const uint64_t key = 0x10ULL;
+  const uint64_t colliding = key + tt.bucketCount();
+  tt.store(key, 5, 3, othello::BoundType::EXACT, 1);
+  othello::TTEntry entry{};
+  EXPECT_FALSE(tt.probe(colliding, entry));
+}
+
+TEST(TranspositionTable, RefreshKeepsKnownBestMove) {
+  othello::TranspositionTable tt(1);
+  tt.store(99, 10, 4, othello::BoundType::LOWER, 19);
+  tt.store(99, 12, 5, othello::BoundType::EXACT, -1);
+  othello::TTEntry entry{};
+  ASSERT_TRUE(tt.probe(99, entry));
+  EXPECT_EQ(entry.score, 12);
+  EXPECT_EQ(entry.depth, 5);
+  EXPECT_EQ(entry.move_index, 19);
+}
+
+TEST(TranspositionTable, FullBucketEvictsShallowestEntry) {
+  othello::TranspositionTable tt(1);
+  const uint64_t stride = tt.bucketCount();
+  // Fill one bucket with depths 9, 2, 8, 7 and then insert a fifth key.
+  const uint8_t depths[] = {9, 2, 8, 7};
+  for (uint64_t i = 0; i < 4; ++i) {
+    tt.store(5 + i * stride, static_cast<int>(i), depths[i],
+             othello::BoundType::EXACT, 0);
+  }
+  tt.store(5 + 4 * stride, 4, 6, othello::BoundType::EXACT, 0);
+
+  othello::TTEntry entry{};
+  EXPECT_TRUE(tt.probe(5, entry));
+  EXPECT_FALSE(tt.probe(5 + 1 * stride, entry));
+  EXPECT_TRUE(tt.probe(5 + 4 * stride, entry));
+}
+
+TEST(TranspositionTable, ClearRemovesEntries) {
+  othello::TranspositionTable tt(1);
+  tt.store(77, 1, 1, othello::BoundType::EXACT, 3);
+  tt.clear();
+  othello::TTEntry entry{};
+  EXPECT_FALSE(tt.probe(77, entry));
+}
+
+TEST(TranspositionTable, StaleGenerationsAreEvictedFirst) {
+  othello::TranspositionTable tt(1);
+  const uint64_t stride = tt.bucketCount();
+  // A deep entry from an old search loses to shallow entries from the
+  // current search once it is a few generations old.
+  tt.store(8, 0, 20, othello::BoundType::EXACT, 0);
+  for (int i = 0; i < 4; ++i) {
+    tt.newSearch();
+  }
+  for (uint64_t i = 1; i < 4; ++i) {
+    tt.store(8 + i * stride, 0, 3, othello::BoundType::EXACT, 0);
+  }
+  tt.store(8 + 4 * stride, 0, 3, othello::BoundType::EXACT, 0);
+
+  othello::TTEntry entry{};
+  EXPECT_FALSE(tt.probe(8, entry));
+  EXPECT_TRUE(tt.probe(8 + 4 * stride, entry));
+  EXPECT_EQ(entry.generation, 4);
+}
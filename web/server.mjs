@@ -145,6 +145,8 @@ function encodeFindBestMoveRequest(payload) {
     encodeField(1, 2, encodeGameState(gameState)),
     encodeField(2, 0, encodeVarint(BigInt(payload?.time_limit_ms ?? 0))),
     encodeField(3, 0, encodeVarint(BigInt(payload?.depth_limit ?? 0))),
+    encodeField(4, 0, encodeVarint(BigInt(payload?.remaining_time_ms ?? 0))),
+    encodeField(5, 0, encodeVarint(BigInt(payload?.increment_ms ?? 0))),
   ]);
 }
 
@@ -180,7 +182,7 @@ function encodeVarint(value) {
 
 function decodeFindBestMoveResponse(buffer) {
   let offset = 0;
-  const result = { best_move: -1, eval_score: 0 };
+  const result = { best_move: -1, eval_score: 0, search_score: 0, solved: false };
 
   while (offset < buffer.length) {
     const tag = readVarint(buffer, offset);
@@ -197,6 +199,10 @@ function decodeFindBestMoveResponse(buffer) {
       result.best_move = toSignedInt32(value.value);
     } else if (fieldNumber === 2) {
       result.eval_score = toSignedInt32(value.value);
+    } else if (fieldNumber === 3) {
+      result.search_score = toSignedInt32(value.value);
+    } else if (fieldNumber === 4) {
+      result.solved = value.value !== 0n;
     }
   }
 